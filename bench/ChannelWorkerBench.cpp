@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+// times the frame handshake of the channel workers: the main thread requests a run
+// and waits for it, the way MultichannelPipeline does once per channel per frame.
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "utils/AtomicChannelWorker.hpp"
+#include "utils/ChannelWorker.hpp"
+
+namespace
+{
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr int32_t ROUND_TRIPS = 20000;
+  constexpr int32_t WARMUP_ROUND_TRIPS = 1000;
+
+  // spins for about as long as the given time, standing in for a render job
+  void busyWork( const std::chrono::microseconds duration )
+  {
+    const auto end = Clock::now() + duration;
+    while ( Clock::now() < end ) {}
+  }
+
+  template < typename TWorker >
+  void runBench( const char * name, const std::chrono::microseconds jobDuration )
+  {
+    TWorker worker( [ jobDuration ] { if ( jobDuration.count() > 0 ) busyWork( jobDuration ); } );
+
+    for ( int32_t i = 0; i < WARMUP_ROUND_TRIPS; ++i )
+    {
+      worker.requestPipelineRun();
+      worker.waitUntilComplete();
+    }
+
+    std::vector< double > samples( ROUND_TRIPS );
+    for ( auto& sample : samples )
+    {
+      const auto start = Clock::now();
+      worker.requestPipelineRun();
+      worker.waitUntilComplete();
+      sample = std::chrono::duration< double, std::micro >( Clock::now() - start ).count();
+    }
+
+    std::ranges::sort( samples );
+
+    // the job itself isn't part of the handshake
+    const auto job = static_cast< double >( jobDuration.count() );
+    std::printf( "%-20s job %4lld us   p50 %8.2f us   p99 %8.2f us   max %9.2f us\n",
+                 name,
+                 static_cast< long long >( jobDuration.count() ),
+                 samples[ samples.size() / 2 ] - job,
+                 samples[ samples.size() * 99 / 100 ] - job,
+                 samples.back() - job );
+  }
+
+}
+
+int main()
+{
+#ifdef DEBUG
+  nx::SLog::initializeNullWriter();
+#endif
+
+  std::printf( "request + wait round trips, minus the job time (%d per run)\n", ROUND_TRIPS );
+
+  // an empty job is the pure handshake. the others are more like a real channel,
+  // where the worker has gone back to sleep by the time the next frame comes in
+  for ( const auto jobDuration : { std::chrono::microseconds( 0 ),
+                                   std::chrono::microseconds( 100 ),
+                                   std::chrono::microseconds( 1000 ) } )
+  {
+    runBench< nx::ChannelWorker >( "ChannelWorker", jobDuration );
+    runBench< nx::AtomicChannelWorker >( "AtomicChannelWorker", jobDuration );
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+// times fading the colors of a layout's particles, the way ParticleLayoutBase does
+// every frame: four colors per particle toward the background. this compares the
+// per-particle getNextColor path it used to take, a plain lerpColor loop and the kernel.
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "helpers/ColorFadeKernel.hpp"
+#include "helpers/ColorHelper.hpp"
+
+namespace
+{
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr size_t PARTICLE_COUNT = 5000;
+  constexpr int32_t FRAME_COUNT = 200;
+
+  const sf::Color FADE_COLORS[ 4 ]
+  {
+    { 255, 128, 0, 255 }, { 12, 200, 90, 255 }, { 90, 90, 255, 200 }, { 255, 255, 255, 128 }
+  };
+
+  // the fastest of all frames, in microseconds
+  template < typename TFn >
+  double timeFrames( TFn&& fn )
+  {
+    double best = std::numeric_limits< double >::max();
+    for ( int32_t i = 0; i < FRAME_COUNT; ++i )
+    {
+      const auto start = Clock::now();
+      fn();
+      best = std::min( best, std::chrono::duration< double, std::micro >( Clock::now() - start ).count() );
+    }
+
+    return best;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng( 7 );
+  std::uniform_real_distribution< float > percentage( 0.f, 1.f );
+
+  std::vector< float > percentages( PARTICLE_COUNT );
+  for ( auto& value : percentages )
+    value = percentage( rng );
+
+  std::vector< sf::Color > colors( PARTICLE_COUNT * 4 );
+  std::vector< sf::Color > expected( PARTICLE_COUNT * 4 );
+
+  const auto nextColor = timeFrames( [ & ]
+  {
+    for ( size_t i = 0; i < PARTICLE_COUNT; ++i )
+    {
+      for ( size_t c = 0; c < 4; ++c )
+        colors[ c * PARTICLE_COUNT + i ] = nx::ColorHelper::getNextColor( FADE_COLORS[ c ], sf::Color::Black, percentages[ i ] );
+    }
+  } );
+
+  const auto lerpColor = timeFrames( [ & ]
+  {
+    for ( size_t c = 0; c < 4; ++c )
+    {
+      for ( size_t i = 0; i < PARTICLE_COUNT; ++i )
+        expected[ c * PARTICLE_COUNT + i ] = nx::ColorHelper::lerpColor( FADE_COLORS[ c ], sf::Color::Black, percentages[ i ] );
+    }
+  } );
+
+  const auto kernel = timeFrames( [ & ]
+  {
+    const std::span out { colors };
+    for ( size_t c = 0; c < 4; ++c )
+      nx::ColorFadeKernel::fade( FADE_COLORS[ c ], sf::Color::Black, percentages, out.subspan( c * PARTICLE_COUNT, PARTICLE_COUNT ) );
+  } );
+
+  size_t mismatches = 0;
+  for ( size_t i = 0; i < colors.size(); ++i )
+  {
+    if ( colors[ i ] != expected[ i ] )
+      ++mismatches;
+  }
+
+#if defined( NX_COLOR_FADE_AVX2 )
+  const char * kernelName = "AVX2";
+#elif defined( NX_COLOR_FADE_SSE2 )
+  const char * kernelName = "SSE2";
+#else
+  const char * kernelName = "scalar";
+#endif
+
+  std::printf( "%zu particles x 4 colors, best of %d frames\n", PARTICLE_COUNT, FRAME_COUNT );
+  std::printf( "  getNextColor per particle   %8.1f us\n", nextColor );
+  std::printf( "  lerpColor loop              %8.1f us\n", lerpColor );
+  std::printf( "  ColorFadeKernel %-11s %8.1f us\n", kernelName, kernel );
+  std::printf( "  colors that differ from lerpColor: %zu\n", mismatches );
+
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+// times building the vertices of 100k curved lines, i.e., a frame of a busy mesh modifier.
+// "before" is how the lines were built up to the batching: a triangle strip per line that
+// got tessellated three times (constructor, setWidth, setGradient).
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "helpers/ColorFadeKernel.hpp"
+#include "helpers/CurvedLineKernel.hpp"
+#include "shapes/CurvedLine.hpp"
+#include "shapes/CurvedLineBatch.hpp"
+
+namespace
+{
+
+  using Clock = std::chrono::steady_clock;
+
+  constexpr size_t LINE_COUNT = 100000;
+  constexpr int32_t SEGMENTS = 20;
+  constexpr float CURVATURE = 0.25f;
+  constexpr float WIDTH = 2.f;
+  constexpr int32_t FRAME_COUNT = 10;
+
+  struct Line_t
+  {
+    sf::Vector2f start;
+    sf::Vector2f end;
+    sf::Color startColor;
+    sf::Color endColor;
+  };
+
+  sf::Vector2f getControlPoint( const sf::Vector2f start, const sf::Vector2f end, const float curvature )
+  {
+    const auto dir = end - start;
+    const auto mid = 0.5f * ( start + end );
+    sf::Vector2f normal( -dir.y, dir.x );
+    const float len = std::sqrt( normal.x * normal.x + normal.y * normal.y );
+    if ( len != 0.f ) normal /= len;
+
+    return mid + normal * curvature * std::sqrt( dir.x * dir.x + dir.y * dir.y );
+  }
+
+  // the per-point math the lines used before the kernel
+  void tessellateScalar( const sf::Vector2f start,
+                         const sf::Vector2f control,
+                         const sf::Vector2f end,
+                         const int32_t segments,
+                         const float width,
+                         const sf::Color startColor,
+                         const sf::Color endColor,
+                         sf::Vertex * left,
+                         sf::Vertex * right,
+                         const size_t stride )
+  {
+    for ( int32_t i = 0; i <= segments; ++i )
+    {
+      const float t = static_cast< float >( i ) / static_cast< float >( segments );
+      const float u = 1.f - t;
+
+      const auto point = u * u * start + 2.f * u * t * control + t * t * end;
+      const sf::Vector2f tangent = 2.f * ( 1.f - t ) * ( control - start ) + 2.f * t * ( end - control );
+
+      sf::Vector2f normal( -tangent.y, tangent.x );
+      const float length = std::sqrt( normal.x * normal.x + normal.y * normal.y );
+      if ( length != 0.f ) normal /= length;
+
+      const auto offset = normal * ( width * 0.5f );
+      const auto color = sf::Color(
+        static_cast< uint8_t >( startColor.r + t * ( endColor.r - startColor.r ) ),
+        static_cast< uint8_t >( startColor.g + t * ( endColor.g - startColor.g ) ),
+        static_cast< uint8_t >( startColor.b + t * ( endColor.b - startColor.b ) ),
+        static_cast< uint8_t >( startColor.a + t * ( endColor.a - startColor.a ) ) );
+
+      left[ i * stride ] = { point - offset, color };
+      right[ i * stride ] = { point + offset, color };
+    }
+  }
+
+  // the line as it was before the batching
+  class StripLine final : public sf::Drawable
+  {
+  public:
+    StripLine( const sf::Vector2f start, const sf::Vector2f end, const float curvature, const int32_t segments )
+      : m_start( start ), m_end( end ), m_curvature( curvature ), m_segments( segments ),
+        m_vertices( sf::PrimitiveType::TriangleStrip, ( segments + 1 ) * 2 )
+    {
+      update();
+    }
+
+    void setWidth( const float width ) { m_width = width; update(); }
+
+    void setGradient( const sf::Color startColor, const sf::Color endColor )
+    {
+      m_startColor = startColor;
+      m_endColor = endColor;
+      update();
+    }
+
+  private:
+    void update()
+    {
+      tessellateScalar( m_start, getControlPoint( m_start, m_end, m_curvature ), m_end,
+                        m_segments, m_width, m_startColor, m_endColor,
+                        &m_vertices[ 0 ], &m_vertices[ 1 ], 2 );
+    }
+
+    void draw( sf::RenderTarget& target, sf::RenderStates states ) const override { target.draw( m_vertices, states ); }
+
+    sf::Vector2f m_start;
+    sf::Vector2f m_end;
+    float m_curvature;
+    int32_t m_segments;
+    float m_width { 1.f };
+    sf::Color m_startColor;
+    sf::Color m_endColor;
+    sf::VertexArray m_vertices;
+  };
+
+  // the fastest of all frames, in milliseconds
+  template < typename TFn >
+  double timeFrames( TFn&& fn )
+  {
+    double best = std::numeric_limits< double >::max();
+    for ( int32_t i = 0; i < FRAME_COUNT; ++i )
+    {
+      const auto start = Clock::now();
+      fn();
+      best = std::min( best, std::chrono::duration< double, std::milli >( Clock::now() - start ).count() );
+    }
+
+    return best;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 rng( 7 );
+  std::uniform_real_distribution< float > coordinate( 0.f, 1920.f );
+  std::uniform_int_distribution< int32_t > channel( 0, 255 );
+
+  const auto randomColor = [ & ]
+  {
+    return sf::Color( channel( rng ), channel( rng ), channel( rng ), channel( rng ) );
+  };
+
+  std::vector< Line_t > lines( LINE_COUNT );
+  for ( auto& line : lines )
+  {
+    line = { { coordinate( rng ), coordinate( rng ) },
+             { coordinate( rng ), coordinate( rng ) },
+             randomColor(),
+             randomColor() };
+  }
+
+  std::vector< sf::Drawable* > drawables;
+  drawables.reserve( LINE_COUNT );
+
+  const auto stripLines = timeFrames( [ & ]
+  {
+    for ( const auto& line : lines )
+    {
+      auto * strip = new StripLine( line.start, line.end, CURVATURE, SEGMENTS );
+      strip->setWidth( WIDTH );
+      strip->setGradient( line.startColor, line.endColor );
+      drawables.push_back( strip );
+    }
+
+    for ( const auto * drawable : drawables )
+      delete drawable;
+
+    drawables.clear();
+  } );
+
+  nx::FrameArena arena;
+
+  const auto singlePassLines = timeFrames( [ & ]
+  {
+    arena.reset();
+    nx::FrameArena::Scope scope( &arena );
+
+    for ( const auto& line : lines )
+    {
+      drawables.push_back( new nx::CurvedLine( line.start, line.end, CURVATURE, SEGMENTS,
+                                               WIDTH, line.startColor, line.endColor ) );
+    }
+
+    for ( const auto * drawable : drawables )
+      delete drawable;
+
+    drawables.clear();
+  } );
+
+  const auto batch = timeFrames( [ & ]
+  {
+    arena.reset();
+    nx::FrameArena::Scope scope( &arena );
+
+    auto * lineBatch = new nx::CurvedLineBatch();
+    lineBatch->reserve( LINE_COUNT, SEGMENTS );
+
+    for ( const auto& line : lines )
+      lineBatch->append( line.start, line.end, CURVATURE, SEGMENTS, WIDTH, line.startColor, line.endColor );
+
+    delete lineBatch;
+  } );
+
+  // just the math, without writing the triangles
+  const auto pointCount = static_cast< size_t >( SEGMENTS ) + 1;
+  const auto paddedCount = nx::CurvedLineKernel::getPaddedCount( SEGMENTS );
+
+  std::vector< sf::Vertex > scalarLeft( pointCount );
+  std::vector< sf::Vertex > scalarRight( pointCount );
+
+  std::vector< float > percentages( paddedCount );
+  std::vector< sf::Vector2f > left( paddedCount );
+  std::vector< sf::Vector2f > right( paddedCount );
+  std::vector< sf::Color > colors( paddedCount );
+
+  const auto scalarMath = timeFrames( [ & ]
+  {
+    for ( const auto& line : lines )
+    {
+      tessellateScalar( line.start, getControlPoint( line.start, line.end, CURVATURE ), line.end,
+                        SEGMENTS, WIDTH, line.startColor, line.endColor,
+                        scalarLeft.data(), scalarRight.data(), 1 );
+    }
+  } );
+
+  const auto kernelMath = timeFrames( [ & ]
+  {
+    for ( const auto& line : lines )
+    {
+      nx::CurvedLineKernel::tessellate( line.start, getControlPoint( line.start, line.end, CURVATURE ), line.end,
+                                        SEGMENTS, WIDTH * 0.5f, percentages, left, right );
+      nx::ColorFadeKernel::fade( line.startColor, line.endColor, percentages, colors );
+    }
+  } );
+
+  // the kernel against the old math, point by point
+  float maxError = 0.f;
+  size_t colorMismatches = 0;
+
+  for ( const auto& line : lines )
+  {
+    const auto control = getControlPoint( line.start, line.end, CURVATURE );
+
+    tessellateScalar( line.start, control, line.end, SEGMENTS, WIDTH, line.startColor, line.endColor,
+                      scalarLeft.data(), scalarRight.data(), 1 );
+    nx::CurvedLineKernel::tessellate( line.start, control, line.end, SEGMENTS, WIDTH * 0.5f, percentages, left, right );
+    nx::ColorFadeKernel::fade( line.startColor, line.endColor, percentages, colors );
+
+    for ( size_t i = 0; i < pointCount; ++i )
+    {
+      const auto leftError = left[ i ] - scalarLeft[ i ].position;
+      const auto rightError = right[ i ] - scalarRight[ i ].position;
+      maxError = std::max( { maxError,
+                             std::abs( leftError.x ), std::abs( leftError.y ),
+                             std::abs( rightError.x ), std::abs( rightError.y ) } );
+
+      if ( colors[ i ] != scalarLeft[ i ].color )
+        ++colorMismatches;
+    }
+  }
+
+#if defined( NX_CURVED_LINE_AVX2 )
+  const char * kernelName = "AVX2";
+#elif defined( NX_CURVED_LINE_SSE2 )
+  const char * kernelName = "SSE2";
+#else
+  const char * kernelName = "scalar";
+#endif
+
+  std::printf( "%zu lines x %d segments, best of %d frames\n", LINE_COUNT, SEGMENTS, FRAME_COUNT );
+  std::printf( "  strip per line, 3 passes (before)   %8.2f ms\n", stripLines );
+  std::printf( "  CurvedLine, single pass             %8.2f ms\n", singlePassLines );
+  std::printf( "  CurvedLineBatch                     %8.2f ms\n", batch );
+  std::printf( "  points + colors only, scalar        %8.2f ms\n", scalarMath );
+  std::printf( "  points + colors only, kernel %-6s %8.2f ms\n", kernelName, kernelMath );
+  std::printf( "  largest position error %g px, colors that differ: %zu\n", maxError, colorMismatches );
+
+  return colorMismatches == 0 && maxError < 1e-2f ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+
+#if defined( __AVX2__ )
+  #include <immintrin.h>
+  #define NX_COLOR_FADE_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+  #include <emmintrin.h>
+  #define NX_COLOR_FADE_SSE2
+#endif
+
+namespace nx
+{
+
+  ///
+  /// Lerps between two colors for many percentages at once. This is what fades
+  /// the particles every frame and what spreads their gradients over their
+  /// vertices, so it runs 8 (AVX2) or 4 (SSE2) colors at a time when it can.
+  ///
+  /// The results match ColorHelper::lerpColor.
+  struct ColorFadeKernel
+  {
+    // out[ i ] = from + ( to - from ) * percentages[ i ]. out has to be at least as big.
+    static void fade( const sf::Color from,
+                      const sf::Color to,
+                      const std::span< const float > percentages,
+                      const std::span< sf::Color > out )
+    {
+      const size_t count = percentages.size();
+      size_t i = 0;
+
+#if defined( NX_COLOR_FADE_AVX2 )
+      const auto fromR = _mm256_set1_ps( from.r );
+      const auto fromG = _mm256_set1_ps( from.g );
+      const auto fromB = _mm256_set1_ps( from.b );
+      const auto fromA = _mm256_set1_ps( from.a );
+
+      const auto deltaR = _mm256_set1_ps( static_cast< float >( to.r - from.r ) );
+      const auto deltaG = _mm256_set1_ps( static_cast< float >( to.g - from.g ) );
+      const auto deltaB = _mm256_set1_ps( static_cast< float >( to.b - from.b ) );
+      const auto deltaA = _mm256_set1_ps( static_cast< float >( to.a - from.a ) );
+
+      const auto zero = _mm256_setzero_ps();
+      const auto one = _mm256_set1_ps( 1.f );
+
+      for ( ; i + 8 <= count; i += 8 )
+      {
+        auto t = _mm256_loadu_ps( percentages.data() + i );
+        t = _mm256_min_ps( _mm256_max_ps( t, zero ), one );
+
+        const auto r = _mm256_cvttps_epi32( _mm256_add_ps( fromR, _mm256_mul_ps( deltaR, t ) ) );
+        const auto g = _mm256_cvttps_epi32( _mm256_add_ps( fromG, _mm256_mul_ps( deltaG, t ) ) );
+        const auto b = _mm256_cvttps_epi32( _mm256_add_ps( fromB, _mm256_mul_ps( deltaB, t ) ) );
+        const auto a = _mm256_cvttps_epi32( _mm256_add_ps( fromA, _mm256_mul_ps( deltaA, t ) ) );
+
+        // sf::Color is r, g, b, a in memory
+        const auto rgba = _mm256_or_si256(
+          _mm256_or_si256( r, _mm256_slli_epi32( g, 8 ) ),
+          _mm256_or_si256( _mm256_slli_epi32( b, 16 ), _mm256_slli_epi32( a, 24 ) ) );
+
+        _mm256_storeu_si256( reinterpret_cast< __m256i * >( out.data() + i ), rgba );
+      }
+#elif defined( NX_COLOR_FADE_SSE2 )
+      const auto fromR = _mm_set1_ps( from.r );
+      const auto fromG = _mm_set1_ps( from.g );
+      const auto fromB = _mm_set1_ps( from.b );
+      const auto fromA = _mm_set1_ps( from.a );
+
+      const auto deltaR = _mm_set1_ps( static_cast< float >( to.r - from.r ) );
+      const auto deltaG = _mm_set1_ps( static_cast< float >( to.g - from.g ) );
+      const auto deltaB = _mm_set1_ps( static_cast< float >( to.b - from.b ) );
+      const auto deltaA = _mm_set1_ps( static_cast< float >( to.a - from.a ) );
+
+      const auto zero = _mm_setzero_ps();
+      const auto one = _mm_set1_ps( 1.f );
+
+      for ( ; i + 4 <= count; i += 4 )
+      {
+        auto t = _mm_loadu_ps( percentages.data() + i );
+        t = _mm_min_ps( _mm_max_ps( t, zero ), one );
+
+        const auto r = _mm_cvttps_epi32( _mm_add_ps( fromR, _mm_mul_ps( deltaR, t ) ) );
+        const auto g = _mm_cvttps_epi32( _mm_add_ps( fromG, _mm_mul_ps( deltaG, t ) ) );
+        const auto b = _mm_cvttps_epi32( _mm_add_ps( fromB, _mm_mul_ps( deltaB, t ) ) );
+        const auto a = _mm_cvttps_epi32( _mm_add_ps( fromA, _mm_mul_ps( deltaA, t ) ) );
+
+        // sf::Color is r, g, b, a in memory
+        const auto rgba = _mm_or_si128(
+          _mm_or_si128( r, _mm_slli_epi32( g, 8 ) ),
+          _mm_or_si128( _mm_slli_epi32( b, 16 ), _mm_slli_epi32( a, 24 ) ) );
+
+        _mm_storeu_si128( reinterpret_cast< __m128i * >( out.data() + i ), rgba );
+      }
+#endif
+
+      for ( ; i < count; ++i )
+        out[ i ] = lerp( from, to, percentages[ i ] );
+    }
+
+  private:
+
+    static sf::Color lerp( const sf::Color from, const sf::Color to, float t )
+    {
+      t = std::clamp( t, 0.f, 1.f );
+      return sf::Color
+      {
+        static_cast< uint8_t >( from.r + ( to.r - from.r ) * t ),
+        static_cast< uint8_t >( from.g + ( to.g - from.g ) * t ),
+        static_cast< uint8_t >( from.b + ( to.b - from.b ) * t ),
+        static_cast< uint8_t >( from.a + ( to.a - from.a ) * t )
+      };
+    }
+  };
+
+  static_assert( sizeof( sf::Color ) == 4, "the SIMD paths store colors as packed 32-bit values" );
+
+}
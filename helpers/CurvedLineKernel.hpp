@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#if defined( __AVX2__ )
+  #include <immintrin.h>
+  #define NX_CURVED_LINE_AVX2
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+  #include <emmintrin.h>
+  #define NX_CURVED_LINE_SSE2
+#endif
+
+namespace nx
+{
+
+  ///
+  /// Tessellates a quadratic curve into the points along both of its edges. Every
+  /// line of a line modifier goes through here every frame, so it works out
+  /// 8 (AVX2) or 4 (SSE2) points at a time when it can.
+  ///
+  /// Point i sits at t = i / segments. The curve is pushed out by half the width
+  /// on either side, along the normal of its tangent at that point.
+  struct CurvedLineKernel
+  {
+#if defined( NX_CURVED_LINE_AVX2 )
+    static constexpr size_t LANE_COUNT = 8;
+#elif defined( NX_CURVED_LINE_SSE2 )
+    static constexpr size_t LANE_COUNT = 4;
+#else
+    static constexpr size_t LANE_COUNT = 1;
+#endif
+
+    // the lines are short, so rather than finishing the last few points one at a
+    // time the kernel runs past the end of the curve. the outputs need this many entries.
+    static constexpr size_t getPaddedCount( const int32_t segments )
+    {
+      return ( static_cast< size_t >( segments ) + LANE_COUNT ) / LANE_COUNT * LANE_COUNT;
+    }
+
+    // percentages, left and right have to hold getPaddedCount( segments ) entries.
+    // the first segments + 1 of them are the curve.
+    static void tessellate( const sf::Vector2f start,
+                            const sf::Vector2f control,
+                            const sf::Vector2f end,
+                            const int32_t segments,
+                            const float halfWidth,
+                            const std::span< float > percentages,
+                            const std::span< sf::Vector2f > left,
+                            const std::span< sf::Vector2f > right )
+    {
+      const size_t count = static_cast< size_t >( segments ) + 1;
+      size_t i = 0;
+
+      // the tangent is 2 * ( u * ( control - start ) + t * ( end - control ) )
+      const sf::Vector2f towardControl = control - start;
+      const sf::Vector2f towardEnd = end - control;
+
+#if defined( NX_CURVED_LINE_AVX2 )
+      const auto startX = _mm256_set1_ps( start.x );
+      const auto startY = _mm256_set1_ps( start.y );
+      const auto controlX = _mm256_set1_ps( control.x );
+      const auto controlY = _mm256_set1_ps( control.y );
+      const auto endX = _mm256_set1_ps( end.x );
+      const auto endY = _mm256_set1_ps( end.y );
+
+      const auto towardControlX = _mm256_set1_ps( towardControl.x );
+      const auto towardControlY = _mm256_set1_ps( towardControl.y );
+      const auto towardEndX = _mm256_set1_ps( towardEnd.x );
+      const auto towardEndY = _mm256_set1_ps( towardEnd.y );
+
+      const auto segmentCount = _mm256_set1_ps( static_cast< float >( segments ) );
+      const auto width = _mm256_set1_ps( halfWidth );
+      const auto zero = _mm256_setzero_ps();
+      const auto one = _mm256_set1_ps( 1.f );
+      const auto two = _mm256_set1_ps( 2.f );
+
+      auto index = _mm256_setr_ps( 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f );
+      const auto step = _mm256_set1_ps( 8.f );
+
+      for ( ; i < count; i += 8, index = _mm256_add_ps( index, step ) )
+      {
+        const auto t = _mm256_div_ps( index, segmentCount );
+        const auto u = _mm256_sub_ps( one, t );
+
+        const auto uu = _mm256_mul_ps( u, u );
+        const auto ut2 = _mm256_mul_ps( two, _mm256_mul_ps( u, t ) );
+        const auto tt = _mm256_mul_ps( t, t );
+
+        const auto pointX = _mm256_add_ps(
+          _mm256_add_ps( _mm256_mul_ps( uu, startX ), _mm256_mul_ps( ut2, controlX ) ),
+          _mm256_mul_ps( tt, endX ) );
+        const auto pointY = _mm256_add_ps(
+          _mm256_add_ps( _mm256_mul_ps( uu, startY ), _mm256_mul_ps( ut2, controlY ) ),
+          _mm256_mul_ps( tt, endY ) );
+
+        const auto tangentX = _mm256_mul_ps( two, _mm256_add_ps(
+          _mm256_mul_ps( u, towardControlX ), _mm256_mul_ps( t, towardEndX ) ) );
+        const auto tangentY = _mm256_mul_ps( two, _mm256_add_ps(
+          _mm256_mul_ps( u, towardControlY ), _mm256_mul_ps( t, towardEndY ) ) );
+
+        // a zero tangent gets no offset rather than a division by zero
+        const auto length = _mm256_sqrt_ps(
+          _mm256_add_ps( _mm256_mul_ps( tangentX, tangentX ), _mm256_mul_ps( tangentY, tangentY ) ) );
+        const auto scale = _mm256_and_ps(
+          _mm256_div_ps( width, length ),
+          _mm256_cmp_ps( length, zero, _CMP_NEQ_OQ ) );
+
+        // the normal is ( -tangent.y, tangent.x )
+        const auto offsetX = _mm256_mul_ps( _mm256_sub_ps( zero, tangentY ), scale );
+        const auto offsetY = _mm256_mul_ps( tangentX, scale );
+
+        _mm256_storeu_ps( percentages.data() + i, t );
+        storePoints( left.data() + i, _mm256_sub_ps( pointX, offsetX ), _mm256_sub_ps( pointY, offsetY ) );
+        storePoints( right.data() + i, _mm256_add_ps( pointX, offsetX ), _mm256_add_ps( pointY, offsetY ) );
+      }
+#elif defined( NX_CURVED_LINE_SSE2 )
+      const auto startX = _mm_set1_ps( start.x );
+      const auto startY = _mm_set1_ps( start.y );
+      const auto controlX = _mm_set1_ps( control.x );
+      const auto controlY = _mm_set1_ps( control.y );
+      const auto endX = _mm_set1_ps( end.x );
+      const auto endY = _mm_set1_ps( end.y );
+
+      const auto towardControlX = _mm_set1_ps( towardControl.x );
+      const auto towardControlY = _mm_set1_ps( towardControl.y );
+      const auto towardEndX = _mm_set1_ps( towardEnd.x );
+      const auto towardEndY = _mm_set1_ps( towardEnd.y );
+
+      const auto segmentCount = _mm_set1_ps( static_cast< float >( segments ) );
+      const auto width = _mm_set1_ps( halfWidth );
+      const auto zero = _mm_setzero_ps();
+      const auto one = _mm_set1_ps( 1.f );
+      const auto two = _mm_set1_ps( 2.f );
+
+      auto index = _mm_setr_ps( 0.f, 1.f, 2.f, 3.f );
+      const auto step = _mm_set1_ps( 4.f );
+
+      for ( ; i < count; i += 4, index = _mm_add_ps( index, step ) )
+      {
+        const auto t = _mm_div_ps( index, segmentCount );
+        const auto u = _mm_sub_ps( one, t );
+
+        const auto uu = _mm_mul_ps( u, u );
+        const auto ut2 = _mm_mul_ps( two, _mm_mul_ps( u, t ) );
+        const auto tt = _mm_mul_ps( t, t );
+
+        const auto pointX = _mm_add_ps(
+          _mm_add_ps( _mm_mul_ps( uu, startX ), _mm_mul_ps( ut2, controlX ) ),
+          _mm_mul_ps( tt, endX ) );
+        const auto pointY = _mm_add_ps(
+          _mm_add_ps( _mm_mul_ps( uu, startY ), _mm_mul_ps( ut2, controlY ) ),
+          _mm_mul_ps( tt, endY ) );
+
+        const auto tangentX = _mm_mul_ps( two, _mm_add_ps(
+          _mm_mul_ps( u, towardControlX ), _mm_mul_ps( t, towardEndX ) ) );
+        const auto tangentY = _mm_mul_ps( two, _mm_add_ps(
+          _mm_mul_ps( u, towardControlY ), _mm_mul_ps( t, towardEndY ) ) );
+
+        // a zero tangent gets no offset rather than a division by zero
+        const auto length = _mm_sqrt_ps(
+          _mm_add_ps( _mm_mul_ps( tangentX, tangentX ), _mm_mul_ps( tangentY, tangentY ) ) );
+        const auto scale = _mm_and_ps(
+          _mm_div_ps( width, length ),
+          _mm_cmpneq_ps( length, zero ) );
+
+        // the normal is ( -tangent.y, tangent.x )
+        const auto offsetX = _mm_mul_ps( _mm_sub_ps( zero, tangentY ), scale );
+        const auto offsetY = _mm_mul_ps( tangentX, scale );
+
+        _mm_storeu_ps( percentages.data() + i, t );
+        storePoints( left.data() + i, _mm_sub_ps( pointX, offsetX ), _mm_sub_ps( pointY, offsetY ) );
+        storePoints( right.data() + i, _mm_add_ps( pointX, offsetX ), _mm_add_ps( pointY, offsetY ) );
+      }
+#endif
+
+      for ( ; i < count; ++i )
+      {
+        const float t = static_cast< float >( i ) / static_cast< float >( segments );
+        const float u = 1.f - t;
+
+        const sf::Vector2f point = u * u * start + 2.f * u * t * control + t * t * end;
+        const sf::Vector2f tangent = 2.f * ( u * towardControl + t * towardEnd );
+
+        const float length = std::sqrt( tangent.x * tangent.x + tangent.y * tangent.y );
+        const float scale = length != 0.f ? halfWidth / length : 0.f;
+        const sf::Vector2f offset { -tangent.y * scale, tangent.x * scale };
+
+        percentages[ i ] = t;
+        left[ i ] = point - offset;
+        right[ i ] = point + offset;
+      }
+    }
+
+  private:
+
+#if defined( NX_CURVED_LINE_AVX2 )
+    // interleaves the x and y of 8 points back into sf::Vector2f
+    static void storePoints( sf::Vector2f * out, const __m256 x, const __m256 y )
+    {
+      // unpacking works within each 128-bit half: 0 1 4 5 and 2 3 6 7
+      const auto low = _mm256_unpacklo_ps( x, y );
+      const auto high = _mm256_unpackhi_ps( x, y );
+
+      auto * floats = reinterpret_cast< float * >( out );
+      _mm256_storeu_ps( floats, _mm256_permute2f128_ps( low, high, 0x20 ) );
+      _mm256_storeu_ps( floats + 8, _mm256_permute2f128_ps( low, high, 0x31 ) );
+    }
+#elif defined( NX_CURVED_LINE_SSE2 )
+    // interleaves the x and y of 4 points back into sf::Vector2f
+    static void storePoints( sf::Vector2f * out, const __m128 x, const __m128 y )
+    {
+      auto * floats = reinterpret_cast< float * >( out );
+      _mm_storeu_ps( floats, _mm_unpacklo_ps( x, y ) );
+      _mm_storeu_ps( floats + 4, _mm_unpackhi_ps( x, y ) );
+    }
+#endif
+  };
+
+  static_assert( sizeof( sf::Vector2f ) == 2 * sizeof( float ), "the SIMD paths store points as pairs of floats" );
+
+}
@@ -17,9 +17,9 @@
 
 namespace nx
 {
-  // the number of channel pipelines to set up
-  // the large the number, the more resources utilized
-  constexpr int32_t MAX_MIDI_CHANNELS = 4;
+  // the number of midi channel pipelines available, which matches the
+  // event bus. a channel only gets set up (thread, textures) once it's used
+  constexpr int32_t MAX_MIDI_CHANNELS = 16;
 
   // the number of audio channels, usually one because stereo gets combined
   // but there might be additional virtual audio channels in the future
@@ -39,6 +39,13 @@ namespace nx
   // the max samples allowed for an average
   constexpr int32_t RENDER_SAMPLES_COUNT = 64;
 
+  // the number of tasks a channel can queue up before they spill onto the heap.
+  // must be a power of two
+  constexpr int32_t TASK_QUEUE_CAPACITY = 64;
+
+  // the largest lambda capture (in bytes) that gets stored inline with a task
+  constexpr int32_t TASK_INLINE_SIZE = 48;
+
   constexpr float MIN_FREQ = 20.f;
   constexpr float MAX_FREQ = 20000.f;
 
@@ -48,4 +55,4 @@ namespace nx
 
   // using AudioProcessorBuffer = std::array< float, FFT_SIZE >;
   using AudioDataBuffer = std::array< float, FFT_BINS >;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -31,6 +31,30 @@ namespace nx
                              const IParticle *particleA,
                              const IParticle *particleB,
                              const bool invertPercentage )
+    {
+      const auto [ startColor, endColor ] = getLineColors( particleA, particleB, invertPercentage );
+      line->setGradient( startColor, endColor );
+    }
+
+    /////////////////////////////////////////////////////////
+    /// updates based on custom colors
+    static void updateCustomLineColors( CurvedLine * line,
+                                 const IParticle * particleA,
+                                 const IParticle * particleB,
+                                 const sf::Color& lineColorA,
+                                 const sf::Color& lineColorB,
+                                 const bool invertPercentage )
+    {
+      const auto [ startColor, endColor ] =
+        getCustomLineColors( particleA, particleB, lineColorA, lineColorB, invertPercentage );
+      line->setGradient( startColor, endColor );
+    }
+
+    /////////////////////////////////////////////////////////
+    /// the start and end colors based on particle colors
+    static std::pair< sf::Color, sf::Color > getLineColors( const IParticle *particleA,
+                                                            const IParticle *particleB,
+                                                            const bool invertPercentage )
     {
       const float percentageA =
       (invertPercentage) ? particleA->getTimeRemainingPercentage() : 1.f - particleA->getTimeRemainingPercentage();
@@ -47,18 +71,17 @@ namespace nx
       const auto lerpedColorB = ColorHelper::lerpColor(colorsB.first, colorsB.second, percentageB);
 
       // now mix those mixed colors for the line
-      line->setGradient(ColorHelper::getColorPercentage(lerpedColorA, percentageA, false ),
-                        ColorHelper::getColorPercentage(lerpedColorB, percentageB, false ) );
+      return { ColorHelper::getColorPercentage(lerpedColorA, percentageA, false ),
+               ColorHelper::getColorPercentage(lerpedColorB, percentageB, false ) };
     }
 
     /////////////////////////////////////////////////////////
-    /// updates based on custom colors
-    static void updateCustomLineColors( CurvedLine * line,
-                                 const IParticle * particleA,
-                                 const IParticle * particleB,
-                                 const sf::Color& lineColorA,
-                                 const sf::Color& lineColorB,
-                                 const bool invertPercentage )
+    /// the start and end colors based on custom colors
+    static std::pair< sf::Color, sf::Color > getCustomLineColors( const IParticle * particleA,
+                                                                  const IParticle * particleB,
+                                                                  const sf::Color& lineColorA,
+                                                                  const sf::Color& lineColorB,
+                                                                  const bool invertPercentage )
     {
       const float percentageA =
       (invertPercentage) ? particleA->getTimeRemainingPercentage() : 1.f - particleA->getTimeRemainingPercentage();
@@ -71,9 +94,9 @@ namespace nx
       const auto lerpedColorB = ColorHelper::lerpColor(lineColorA, lineColorB, percentageB);
 
       // now mix those mixed colors for the line
-      line->setGradient(ColorHelper::getColorPercentage(lerpedColorA, percentageA, false ),
-                        ColorHelper::getColorPercentage(lerpedColorB, percentageB, false ) );
+      return { ColorHelper::getColorPercentage(lerpedColorA, percentageA, false ),
+               ColorHelper::getColorPercentage(lerpedColorB, percentageB, false ) };
     }
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
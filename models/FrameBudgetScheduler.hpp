@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <thread>
+
+#include "helpers/Definitions.hpp"
+#include "utils/RingBufferAverager.hpp"
+
+namespace nx
+{
+
+  // each level includes the ones before it
+  enum class E_DegradeLevel : int8_t
+  {
+    E_None,
+    E_ReducedSegments,
+    E_SkipOptionalShaders,
+    E_ReuseTexture
+  };
+
+  ///
+  /// Keeps the channels inside a frame budget by stepping their quality down
+  /// (and back up) one level at a time, based on the averaged render times.
+  ///
+  /// A channel that blows the budget on its own gets degraded regardless of its
+  /// priority. When the channels together need more time than there are cores
+  /// for, the lowest priority channel gets degraded first and recovers last.
+  class FrameBudgetScheduler final
+  {
+    using Clock = RingBufferAverager::Clock;
+    using TimePoint = RingBufferAverager::TimePoint;
+
+    struct ChannelBudget_t
+    {
+      E_DegradeLevel level { E_DegradeLevel::E_None };
+
+      // only set for the channels that are drawn this frame
+      bool isScheduled { false };
+      double costInMs { 0.0 };
+      int32_t priority { 0 };
+
+      // reusing the texture renders every other frame
+      bool skipNextFrame { false };
+
+      TimePoint lastChange {};
+      TimePoint lastDegraded {};
+    };
+
+  public:
+
+    FrameBudgetScheduler()
+      : m_parallelism( std::max( 1u, std::thread::hardware_concurrency() ) )
+    {}
+
+    [[nodiscard]]
+    bool isEnabled() const { return m_isEnabled; }
+
+    // called before schedule() for every channel that gets drawn this frame
+    void setChannelLoad( const int32_t channelIndex,
+                         const double costInMs,
+                         const int32_t priority )
+    {
+      auto& channel = m_channels[ channelIndex ];
+      channel.isScheduled = true;
+      channel.costInMs = costInMs;
+      channel.priority = priority;
+    }
+
+    void schedule()
+    {
+      const auto now = Clock::now();
+
+      if ( !m_isEnabled )
+      {
+        for ( auto& channel : m_channels )
+        {
+          channel.level = E_DegradeLevel::E_None;
+          channel.isScheduled = false;
+        }
+
+        return;
+      }
+
+      // the channels render side by side, so they only
+      // compete with each other once the cores run out
+      double totalCostInMs = 0.0;
+      for ( const auto& channel : m_channels )
+      {
+        if ( channel.isScheduled )
+          totalCostInMs += getCostPerFrame( channel );
+      }
+
+      const bool isOverloaded = totalCostInMs / m_parallelism > m_budgetInMs;
+
+      // a channel that can't make it on its own
+      for ( auto& channel : m_channels )
+      {
+        if ( channel.isScheduled &&
+             channel.costInMs > m_budgetInMs &&
+             canChange( channel, now ) )
+        {
+          degrade( channel, now );
+        }
+      }
+
+      if ( isOverloaded )
+      {
+        if ( auto * channel = findChannel( now, true ) )
+          degrade( *channel, now );
+      }
+      else if ( auto * channel = findChannel( now, false ) )
+      {
+        // the cost was measured at the degraded level, so leave plenty of headroom
+        if ( channel->costInMs < m_budgetInMs * RECOVERY_RATIO )
+        {
+          channel->level = static_cast< E_DegradeLevel >( static_cast< int8_t >( channel->level ) - 1 );
+          channel->lastChange = now;
+        }
+      }
+
+      for ( auto& channel : m_channels )
+      {
+        if ( channel.level != E_DegradeLevel::E_None )
+          channel.lastDegraded = now;
+
+        channel.isScheduled = false;
+      }
+    }
+
+    [[nodiscard]]
+    E_DegradeLevel getLevel( const int32_t channelIndex ) const
+    {
+      return m_channels[ channelIndex ].level;
+    }
+
+    // false when the channel should present its previous output instead.
+    // this is meant to be called once per frame.
+    [[nodiscard]]
+    bool shouldRender( const int32_t channelIndex )
+    {
+      auto& channel = m_channels[ channelIndex ];
+      if ( channel.level != E_DegradeLevel::E_ReuseTexture )
+      {
+        channel.skipNextFrame = false;
+        return true;
+      }
+
+      channel.skipNextFrame = !channel.skipNextFrame;
+      return channel.skipNextFrame;
+    }
+
+    // whether the channel was degraded within the last second
+    [[nodiscard]]
+    bool wasRecentlyDegraded( const int32_t channelIndex ) const
+    {
+      const auto& lastDegraded = m_channels[ channelIndex ].lastDegraded;
+      return lastDegraded != TimePoint {} &&
+             Clock::now() - lastDegraded < std::chrono::seconds( 1 );
+    }
+
+    void drawMenu()
+    {
+      ImGui::Checkbox( "Frame Budget", &m_isEnabled );
+      ImGui::SliderFloat( "Budget (ms)", &m_budgetInMs, 4.f, 50.f );
+    }
+
+    static const char * getLevelName( const E_DegradeLevel level )
+    {
+      switch ( level )
+      {
+        case E_DegradeLevel::E_ReducedSegments: return "Reduced Segments";
+        case E_DegradeLevel::E_SkipOptionalShaders: return "Skipped Shaders";
+        case E_DegradeLevel::E_ReuseTexture: return "Reused Texture";
+        default: return "None";
+      }
+    }
+
+  private:
+
+    [[nodiscard]]
+    static double getCostPerFrame( const ChannelBudget_t& channel )
+    {
+      return channel.level == E_DegradeLevel::E_ReuseTexture
+        ? channel.costInMs * 0.5
+        : channel.costInMs;
+    }
+
+    // the averages need some time to reflect a change
+    [[nodiscard]]
+    static bool canChange( const ChannelBudget_t& channel, const TimePoint now )
+    {
+      return now - channel.lastChange >= LEVEL_COOLDOWN;
+    }
+
+    static void degrade( ChannelBudget_t& channel, const TimePoint now )
+    {
+      if ( channel.level == E_DegradeLevel::E_ReuseTexture ) return;
+
+      channel.level = static_cast< E_DegradeLevel >( static_cast< int8_t >( channel.level ) + 1 );
+      channel.lastChange = now;
+    }
+
+    // the lowest priority channel that can still degrade, or
+    // the highest priority channel that can still recover
+    ChannelBudget_t * findChannel( const TimePoint now, const bool toDegrade )
+    {
+      ChannelBudget_t * found = nullptr;
+
+      for ( auto& channel : m_channels )
+      {
+        if ( !channel.isScheduled || !canChange( channel, now ) ) continue;
+
+        if ( toDegrade )
+        {
+          if ( channel.level == E_DegradeLevel::E_ReuseTexture ) continue;
+          if ( found == nullptr || channel.priority < found->priority )
+            found = &channel;
+        }
+        else
+        {
+          if ( channel.level == E_DegradeLevel::E_None ) continue;
+          if ( found == nullptr || channel.priority > found->priority )
+            found = &channel;
+        }
+      }
+
+      return found;
+    }
+
+  private:
+
+    std::array< ChannelBudget_t, MAX_CHANNELS > m_channels;
+
+    const uint32_t m_parallelism;
+
+    bool m_isEnabled { false };
+    float m_budgetInMs { 1000.f / 60.f };
+
+    static constexpr auto LEVEL_COOLDOWN = std::chrono::milliseconds( 500 );
+    static constexpr double RECOVERY_RATIO = 0.5;
+  };
+
+}
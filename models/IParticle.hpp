@@ -15,8 +15,11 @@
 
 #pragma once
 
+#include <span>
+
 namespace nx
 {
+  class ParticleBatch;
 
   struct IParticle : public sf::Drawable,
                      public sf::Transformable
@@ -32,8 +35,8 @@ namespace nx
 
     virtual float getTimeAliveInSeconds() const = 0;
 
-    // used for updating the expiration time
-    virtual void update( const sf::Time& deltaTime ) = 0;
+    // the particle store runs the clocks and hands them back once per frame
+    virtual void setTimeAliveInSeconds( float timeAliveInSeconds ) = 0;
 
     // this is automatically created
     virtual float getSpawnTimeInSeconds() const = 0;
@@ -55,6 +58,10 @@ namespace nx
 
     virtual float getRadius() const = 0;
 
+    // adds the particle as transformed triangles, so that it can be drawn together
+    // with the others in one call. the result looks the same as draw().
+    virtual void appendTo( ParticleBatch& batch ) const = 0;
+
     virtual sf::FloatRect getLocalBounds() const = 0;
     virtual sf::FloatRect getGlobalBounds() const = 0;
 
@@ -71,4 +78,7 @@ namespace nx
     virtual void setEnergy( const float energy ) = 0;
     virtual float getEnergy() const = 0;
   };
+
+  // what the modifiers and renderers iterate over. the particles are owned elsewhere.
+  using ParticleSpan = std::span< IParticle * const >;
 }
\ No newline at end of file
@@ -19,19 +19,23 @@
 #include "models/ISerializable.hpp"
 #include "models/IParticle.hpp"
 #include "models/data/ParticleData_t.hpp"
+#include "models/data/ParticleFields_t.hpp"
 
 namespace nx
 {
-
   struct IParticleBehavior : public ISerializable< E_BehaviorType >
   {
     ~IParticleBehavior() override = default;
     virtual void applyOnSpawn( IParticle * p,
                                const ParticleData_t& particleData ) = 0;
 
-    virtual void applyOnUpdate( IParticle * p,
+    // called once per frame with the particle arrays of a layout. the particles
+    // are moved through the positions, so that the math runs as tight loops over
+    // plain floats. the store hands the positions to the particles afterwards.
+    virtual void applyOnUpdate( const ParticleFields_t& fields,
                                 const sf::Time& deltaTime,
                                 const ParticleData_t& particleData ) = 0;
+
     virtual void drawMenu() = 0;
   };
 
@@ -17,10 +17,10 @@
 
 #include "models/IParticleModifier.hpp"
 #include "models/IParticleGenerator.hpp"
+#include "models/data/ParticleLimit_t.hpp"
 
 namespace nx
 {
-
   class ParticleSequentialLineModifier;
   class ParticleFullMeshLineModifier;
   class PassthroughParticleModifier;
@@ -47,12 +47,18 @@ namespace nx
     virtual const ParticleData_t& getParticleData() const = 0;
 
     /// the implementation of IParticleLayout is the owner of the IParticle
-    /// objects. the primary reason why they are not shared_ptr is because shared_ptr
-    /// will still leak by inadvertently neglecting to remove objects from the deque.
-    /// all particles in the deque get operated on by downstream objects, so if there's a
-    /// null dereference then errors will immediately be known and easy to trace.
+    /// objects (see ParticleStore). the primary reason why they are not shared_ptr is
+    /// because shared_ptr will still leak by inadvertently neglecting to remove objects
+    /// from the store. all particles in the span get operated on by downstream objects,
+    /// so if there's a null dereference then errors will immediately be known and easy to trace.
     [[nodiscard]]
-    virtual std::deque< IParticle* >& getParticles() = 0;
+    virtual ParticleSpan getParticles() const = 0;
+
+    // set by the particle budget before every update
+    virtual void setParticleLimit( const ParticleLimit_t& limit ) {}
+
+    // the particles evicted or thinned out because of the limit since the last call
+    virtual size_t takeDroppedParticleCount() { return 0; }
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -21,8 +21,12 @@
 
 #include "models/data/Midi_t.hpp"
 
+#include "shapes/CurvedLineBatch.hpp"
+
 namespace nx
 {
+  class SpatialGrid;
+
   struct IParticleModifier : public ISerializable< E_ModifierType >
   {
     ~IParticleModifier() override = default;
@@ -36,12 +40,40 @@ namespace nx
 
     virtual void processMidiEvent( const Midi_t& midiEvent ) = 0;
 
+    // lets the frame budget trade curve detail for time. 1 is full detail.
+    virtual void setDetailScale( float detailScale ) {}
+
+    // how far this modifier looks for neighbors. the pipeline only builds its
+    // neighbor index when an active modifier returns more than 0.
+    [[nodiscard]]
+    virtual float getNeighborRadius() const { return 0.f; }
+
+    // the pipeline's neighbor index, built from the same particles that modify()
+    // gets, with cells at least as big as getNeighborRadius(). it's only valid during modify().
+    virtual void setSpatialGrid( const SpatialGrid * spatialGrid ) {}
+
     /// @param blendMode blend mode for particle layers
     /// @param particles particles generated by IParticleLayout
     /// @param outArtifacts Ownership is handed off. do NOT manage memory. artifacts are ephemeral.
     virtual void modify(
        const sf::BlendMode& blendMode,
-       std::deque< IParticle* >& particles,
-       std::deque< sf::Drawable* >& outArtifacts ) = 0;
+       ParticleSpan particles,
+       std::vector< sf::Drawable* >& outArtifacts ) = 0;
+
+  protected:
+
+    static int32_t scaleSegments( const int32_t segments, const float detailScale )
+    {
+      return std::max( 1, static_cast< int32_t >( static_cast< float >( segments ) * detailScale ) );
+    }
+
+    // hands the lines over as a single artifact, so they get drawn in one call
+    static void emitLines( CurvedLineBatch * lines, std::vector< sf::Drawable* >& outArtifacts )
+    {
+      if ( lines->empty() )
+        delete lines;
+      else
+        outArtifacts.push_back( lines );
+    }
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
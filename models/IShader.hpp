@@ -46,9 +46,22 @@ namespace nx
     [[nodiscard]]
     virtual bool isShaderActive() const = 0;
 
+    // whether the output can change without any new input
+    [[nodiscard]]
+    virtual bool isAnimating() const { return true; }
+
+    // blends in its own previous output, so it keeps changing after the input stops
+    [[nodiscard]]
+    virtual bool hasFeedback() const { return false; }
+
+    // optional passes are purely cosmetic and carry no state between frames,
+    // so they get skipped first when a channel runs over its frame budget
+    [[nodiscard]]
+    virtual bool isOptional() const { return false; }
+
     [[nodiscard]]
     virtual sf::RenderTexture * applyShader(
       const sf::RenderTexture * inputTexture ) = 0;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
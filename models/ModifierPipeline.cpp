@@ -14,6 +14,7 @@
  */
 
 #include "models/ModifierPipeline.hpp"
+#include "models/ParticlePool.hpp"
 
 #include "models/modifier/MirrorModifier.hpp"
 #include "models/modifier/ParticleFullMeshLineModifier.hpp"
@@ -105,33 +106,104 @@ namespace nx
   }
 
   sf::RenderTexture * ModifierPipeline::applyModifiers(
-    std::deque< IParticle* >& particles,
+    const ParticleSpan particles,
     const sf::BlendMode& blendMode )
   {
     m_outputTexture.ensureSize( m_ctx.globalInfo.windowSize );
 
-    std::deque< sf::Drawable* > newArtifacts;
+    resetArtifactArenas();
 
+    const auto * spatialGrid = rebuildSpatialGrid( particles );
+
+    // modifiers can be added at any time, so they all get the current detail
     for ( const auto& modifier : m_modifiers )
     {
-      if ( modifier->isActive() )
-        modifier->modify( blendMode, particles, newArtifacts );
+      modifier->setDetailScale( m_detailScale );
+      modifier->setSpatialGrid( spatialGrid );
+    }
+
+    if ( m_taskPool != nullptr && m_modifiers.size() > 1 )
+      applyModifiersInParallel( blendMode, particles, m_artifacts );
+    else
+    {
+      for ( size_t i = 0; i < m_modifiers.size(); ++i )
+      {
+        if ( !m_modifiers[ i ]->isActive() ) continue;
+
+        FrameArena::Scope arenaScope( m_artifactArenas[ i ].get() );
+        m_modifiers[ i ]->modify( blendMode, particles, m_artifacts );
+      }
     }
 
     m_outputTexture.clear( sf::Color::Transparent );
 
-    drawArtifacts( newArtifacts, m_blendMode );
+    drawArtifacts( m_artifacts, m_blendMode );
+    m_artifacts.clear();
     drawParticles( particles, blendMode );
 
     m_outputTexture.display();
     return m_outputTexture.get();
   }
 
+  const SpatialGrid * ModifierPipeline::rebuildSpatialGrid( const ParticleSpan particles )
+  {
+    float radius = 0.f;
+    for ( const auto& modifier : m_modifiers )
+    {
+      if ( modifier->isActive() )
+        radius = std::max( radius, modifier->getNeighborRadius() );
+    }
+
+    if ( radius <= 0.f )
+    {
+      m_spatialGrid.clear();
+      return nullptr;
+    }
+
+    // cells as big as the largest radius keep every query to about 3x3 cells
+    m_spatialGrid.rebuild( particles, radius );
+    return &m_spatialGrid;
+  }
+
+  void ModifierPipeline::applyModifiersInParallel(
+    const sf::BlendMode& blendMode,
+    const ParticleSpan particles,
+    std::vector< sf::Drawable* >& outArtifacts )
+  {
+    m_modifierArtifacts.resize( m_modifiers.size() );
+
+    // modifiers only read the particles and own their state, so each one
+    // can tessellate on its own as long as the draw order is kept afterward
+    TaskGroup group;
+    for ( size_t i = 0; i < m_modifiers.size(); ++i )
+    {
+      if ( !m_modifiers[ i ]->isActive() ) continue;
+
+      // clones made by the modifiers still belong to this channel's pool
+      m_taskPool->submit( group, [ this, i, &blendMode, particles, pool = ParticlePool::getCurrent() ]
+      {
+        ParticlePool::Scope poolScope( pool );
+        FrameArena::Scope arenaScope( m_artifactArenas[ i ].get() );
+        m_modifiers[ i ]->modify( blendMode, particles, m_modifierArtifacts[ i ] );
+      } );
+    }
+
+    m_taskPool->wait( group );
+
+    for ( auto& artifacts : m_modifierArtifacts )
+    {
+      outArtifacts.insert( outArtifacts.end(), artifacts.begin(), artifacts.end() );
+      artifacts.clear();
+    }
+  }
+
   void ModifierPipeline::drawModifierPipelineMenu()
   {
     ImGui::Separator();
     ImGui::Text( "Modifiers: %ld", m_modifiers.size() );
     ImGui::Text( "Artifacts: %ld", m_artifactCount );
+    ImGui::Text( "Artifact Arena: %zu KB", m_artifactArenaBytes / 1024 );
+    ImGui::Text( "Particle Vertices: %ld", m_particleVertexCount );
 
     int deletePos = -1;
     int swapA = -1;
@@ -220,4 +292,4 @@ namespace nx
     }
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
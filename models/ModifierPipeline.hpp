@@ -17,8 +17,13 @@
 
 #include "models/modifier/ParticleFullMeshLineModifier.hpp"
 
+#include "models/ParticleBatch.hpp"
+#include "models/SpatialGrid.hpp"
+
 #include "data/PipelineContext.hpp"
+#include "utils/FrameArena.hpp"
 #include "utils/LazyTexture.hpp"
+#include "utils/WorkStealingPool.hpp"
 
 namespace nx
 {
@@ -58,28 +63,82 @@ public:
 
   void processMidiEvent( const Midi_t& midiEvent ) const;
 
+  // when set, the active modifiers tessellate in parallel on the pool
+  void setTaskPool( WorkStealingPool * taskPool ) { m_taskPool = taskPool; }
+
+  // used by the frame budget. only call this from the render thread.
+  void setDetailScale( const float detailScale ) { m_detailScale = detailScale; }
+
   sf::RenderTexture * applyModifiers(
-    std::deque< IParticle* >& particles,
+    ParticleSpan particles,
     const sf::BlendMode& blendMode );
 
 private:
 
-  void drawParticles( const std::deque< IParticle* >& particles,
+  void drawParticles( const ParticleSpan particles,
                       const sf::BlendMode& blendMode )
   {
+    m_particleBatch.clear();
     for ( const auto * particle : particles )
-      m_outputTexture.draw( *particle, blendMode );
+      particle->appendTo( m_particleBatch );
+
+    m_particleVertexCount = m_particleBatch.getVertexCount();
+    m_outputTexture.draw( m_particleBatch, blendMode );
   }
 
-  void drawArtifacts( const std::deque< sf::Drawable* >& artifacts,
+  void drawArtifacts( const std::vector< sf::Drawable* >& artifacts,
                       const sf::BlendMode& blendMode )
   {
     m_artifactCount = artifacts.size();
+
+    m_artifactArenaBytes = 0;
+    for ( const auto& arena : m_artifactArenas )
+      m_artifactArenaBytes += arena->getUsedBytes();
+
+    // particles made by the modifiers are batched up to the next artifact
+    // that isn't a particle, so the draw order stays the same
+    m_particleBatch.clear();
     for ( const auto * artifact : artifacts )
     {
-      m_outputTexture.draw( *artifact, blendMode );
+      if ( const auto * particle = dynamic_cast< const IParticle * >( artifact ) )
+      {
+        particle->appendTo( m_particleBatch );
+      }
+      else
+      {
+        flushParticleBatch( blendMode );
+        m_outputTexture.draw( *artifact, blendMode );
+      }
+
       delete artifact;
     }
+
+    flushParticleBatch( blendMode );
+  }
+
+  void flushParticleBatch( const sf::BlendMode& blendMode )
+  {
+    if ( m_particleBatch.empty() ) return;
+
+    m_outputTexture.draw( m_particleBatch, blendMode );
+    m_particleBatch.clear();
+  }
+
+  void applyModifiersInParallel( const sf::BlendMode& blendMode,
+                                 ParticleSpan particles,
+                                 std::vector< sf::Drawable* >& outArtifacts );
+
+  // only when an active modifier looks for neighbors. returns null otherwise.
+  const SpatialGrid * rebuildSpatialGrid( ParticleSpan particles );
+
+  // the artifacts of the last frame are gone by now, so their memory can be reused
+  void resetArtifactArenas()
+  {
+    while ( m_artifactArenas.size() < m_modifiers.size() )
+      m_artifactArenas.push_back( std::make_unique< FrameArena >() );
+
+    for ( const auto& arena : m_artifactArenas )
+      arena->reset();
   }
 
   void drawModifierPipelineMenu();
@@ -116,6 +175,25 @@ private:
   std::vector< std::unique_ptr< IParticleModifier > > m_modifiers;
 
   size_t m_artifactCount { 0 };
+  size_t m_artifactArenaBytes { 0 };
+  size_t m_particleVertexCount { 0 };
+
+  // reused every frame so the vertices keep their capacity
+  ParticleBatch m_particleBatch;
+
+  float m_detailScale { 1.f };
+
+  // shared by the modifiers that need neighbors
+  SpatialGrid m_spatialGrid;
+
+  WorkStealingPool * m_taskPool { nullptr };
+
+  // reused every frame so the lists keep their capacity
+  std::vector< sf::Drawable* > m_artifacts;
+
+  // one list and one arena per modifier so they can be filled concurrently
+  std::vector< std::vector< sf::Drawable* > > m_modifierArtifacts;
+  std::vector< std::unique_ptr< FrameArena > > m_artifactArenas;
 };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
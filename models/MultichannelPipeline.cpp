@@ -15,6 +15,8 @@
 
 #include "models/MultichannelPipeline.hpp"
 
+#include <algorithm>
+
 #include "channel/MidiChannelPipeline.hpp"
 #include "data/PipelineContext.hpp"
 #include "models/EventRecorder.hpp"
@@ -28,55 +30,141 @@ namespace nx
   MultichannelPipeline::MultichannelPipeline( PipelineContext& context )
     : m_ctx( context )
   {
-    // set up the audio data channel pipeline, which is the first one
-    m_channels[ AUDIO_CHANNEL_INDEX ] = std::make_unique< AudioChannelPipeline >( context, 0 );
-    m_channelWorkers[ AUDIO_CHANNEL_INDEX ] = std::make_unique< ChannelWorker >(
-      [ this ]
-      {
-        m_channels[ AUDIO_CHANNEL_INDEX ]->runTasks();
-      } );
+#ifdef NX_RENDER_POOL
+    m_renderPool = std::make_unique< WorkStealingPool >();
+#endif
+
+    // the audio data channel pipeline is fed every frame, so it's always set up.
+    // the midi channels are set up once they receive an event or get enabled in the menu
+    activateChannel( AUDIO_CHANNEL_INDEX );
 
-    // set up the midi channel pipelines
-    for ( int32_t i = MIDI_CHANNEL_INDEX; i < m_channels.size(); ++i )
-    {
-      m_channels[ i ] = std::make_unique< MidiChannelPipeline >( context, i );
-      m_channelWorkers[ i ] = std::make_unique< ChannelWorker >(
-       [ this, i ]
-       {
-         // run all the tasks but ONLY on this thread
-         m_channels[ i ]->runTasks();
-       } );
-    }
     m_messageClock.setMessage( "...welcome to nxvst..." );
   }
 
+  void MultichannelPipeline::activateChannel( const int32_t channelIndex )
+  {
+    if ( m_channels[ channelIndex ] ) return;
+
+    if ( channelIndex == AUDIO_CHANNEL_INDEX )
+      m_channels[ channelIndex ] = std::make_unique< AudioChannelPipeline >( m_ctx, channelIndex );
+    else
+      m_channels[ channelIndex ] = std::make_unique< MidiChannelPipeline >( m_ctx, channelIndex );
+
+    m_channelWorkers[ channelIndex ] = createChannelWorker( channelIndex );
+    m_channels[ channelIndex ]->setActiveChannels( &m_activeChannels );
+
+    m_activeChannels.insert(
+      std::upper_bound( m_activeChannels.begin(), m_activeChannels.end(), channelIndex ),
+      channelIndex );
+
+    LOG_INFO( "Channel {} activated", channelIndex );
+  }
+
+  void MultichannelPipeline::deactivateChannel( const int32_t channelIndex )
+  {
+    if ( !m_channels[ channelIndex ] ) return;
+
+    // the textures belong to the worker, so it has to release them itself
+    collectChannel( channelIndex );
+    m_channels[ channelIndex ]->requestShutdown();
+    m_channelWorkers[ channelIndex ]->requestPipelineRun();
+    m_channelWorkers[ channelIndex ]->waitUntilComplete();
+
+    // the worker runs the channel's tasks, so it goes first
+    m_channelWorkers[ channelIndex ].reset();
+    m_channels[ channelIndex ].reset();
+
+    auto& state = m_frameStates[ channelIndex ];
+    state.output = nullptr;
+    state.outputFence = nullptr;
+
+    std::erase( m_activeChannels, channelIndex );
+
+    LOG_INFO( "Channel {} deactivated", channelIndex );
+  }
+
+  std::unique_ptr< IChannelWorker > MultichannelPipeline::createChannelWorker( const int32_t channelIndex )
+  {
+    auto pipelineFn = [ this, channelIndex ]
+    {
+      // run all the tasks but ONLY on this thread
+      m_channels[ channelIndex ]->runTasks();
+    };
+
+#ifdef NX_RENDER_POOL
+    // the channel always renders on the same pool worker, which owns its textures
+    m_channels[ channelIndex ]->setTaskPool( m_renderPool.get() );
+    return std::make_unique< PooledChannelWorker >( *m_renderPool, channelIndex, std::move( pipelineFn ) );
+#elif defined( NX_ATOMIC_HANDSHAKE )
+    return std::make_unique< AtomicChannelWorker >( std::move( pipelineFn ) );
+#else
+    return std::make_unique< ChannelWorker >( std::move( pipelineFn ) );
+#endif
+  }
+
   [[nodiscard]]
   nlohmann::json MultichannelPipeline::saveState() const
   {
-    nlohmann::json j = nlohmann::json::array();
+    nlohmann::json j = {};
+    auto& channels = j[ "channels" ] = nlohmann::json::array();
 
-    for ( int i = 0; i < m_channels.size(); ++i )
+    // channels that aren't set up are saved as null to keep the indices intact
+    for ( const auto i : m_activeChannels )
     {
-      j[ i ] = m_channels[ i ]->saveChannelPipeline();
-      LOG_INFO( j[ i ].dump() );
+      channels[ i ] = m_channels[ i ]->saveChannelPipeline();
+      LOG_INFO( channels[ i ].dump() );
     }
 
+    j[ "particleBudget" ] = m_particleBudget.serialize();
     return j;
   }
 
-  void MultichannelPipeline::restoreState( const nlohmann::json &j ) const
+  void MultichannelPipeline::restoreState( const nlohmann::json &j )
   {
-    for ( int i = 0; i < j.size(); ++i )
-      m_channels[ i ]->loadChannelPipeline( j.at( i ) );
+    // the channels get rebuilt, so nothing can be rendering
+    collectAllChannels();
+
+    // older states are only the list of channels
+    const bool isChannelList = j.is_array();
+    if ( !isChannelList && !( j.contains( "channels" ) && j.at( "channels" ).is_array() ) )
+    {
+      LOG_WARN( "Deserializer: No channels found in the pipeline state" );
+      return;
+    }
+
+    const auto& channels = isChannelList ? j : j.at( "channels" );
+
+    if ( !isChannelList && j.contains( "particleBudget" ) )
+      m_particleBudget.deserialize( j.at( "particleBudget" ) );
+
+    for ( int i = 0; i < m_channels.size(); ++i )
+    {
+      // channels that weren't in use when the state was saved aren't in use now either
+      if ( i >= channels.size() || channels.at( i ).is_null() )
+      {
+        deactivateChannel( i );
+        continue;
+      }
+
+      activateChannel( i );
+      m_channels[ i ]->loadChannelPipeline( channels.at( i ) );
+      m_channels[ i ]->markDirty();
+    }
+
+    // the audio channel is always set up. without saved state it starts over with the defaults.
+    activateChannel( AUDIO_CHANNEL_INDEX );
   }
 
-  void MultichannelPipeline::processMidiEvent( const Midi_t &midi ) const
+  void MultichannelPipeline::processMidiEvent( const Midi_t &midi )
   {
     const auto midiChannel = midi.channel + MIDI_CHANNEL_INDEX;
 
     if ( midiChannel < m_channels.size() )
     {
-      static_cast< MidiChannelPipeline * >( m_channels.at( midiChannel ).get() )->processMidiEvent( midi );
+      activateChannel( midiChannel );
+
+      // picked up by the channel's next job
+      m_channels[ midiChannel ]->queueMidiEvent( midi );
     }
 
     if ( m_encoder ) m_encoder->addMidiEvent( midi );
@@ -84,7 +172,15 @@ namespace nx
 
   void MultichannelPipeline::processAudioData( FFTBuffer& buffer )
   {
-    static_cast< AudioChannelPipeline * >( m_channels.at( AUDIO_CHANNEL_INDEX ).get() )->processAudioBuffer( buffer );
+    // the audio channel does the scaling on its own thread. each FFT frame is
+    // handed over once, so the particle load follows the audio rate.
+    auto& channel = *m_channels.at( AUDIO_CHANNEL_INDEX );
+    buffer.consumeFrames( [ &channel ]( const AudioDataBuffer& frame )
+    {
+      channel.queueAudioData( frame );
+    } );
+
+    m_droppedAudioFrameCount = buffer.getDroppedFrameCount();
     m_audioDataAverage.addSample( static_cast< double >( buffer.getAge().count() ) );
   }
 
@@ -92,20 +188,103 @@ namespace nx
   {
     m_totalRenderAverage.startTimer();
 
+    m_idleChannelCount = 0;
+    scheduleFrameBudget();
+    scheduleParticleBudget();
+
+    if ( m_isPipelined )
+      drawPipelined( window );
+    else
+      drawSynchronized( window );
+
+    // now that we have a final image, send it to the video encoder
+    // and make sure we start at the right time
+    if ( m_encoder )
+    {
+      if ( m_encoder->isRecording() ) m_encoder->writeFrame( m_ctx.globalInfo.playhead, window );
+      else
+      {
+        m_messageClock.setMessage( "Encoder failed. NOT recording." );
+        m_encoder.reset( nullptr );
+      }
+    }
+
+    // video encoding gets added whenever available,
+    // but there's no separate one right now for video encoding
+    // unless it becomes a problem
+    m_totalRenderAverage.stopTimerAndAddSample();
+  }
+
+  void MultichannelPipeline::scheduleFrameBudget()
+  {
+    for ( const auto i : m_activeChannels )
+    {
+      if ( m_channels[ i ]->isBypassed() ) continue;
+
+      m_budgetScheduler.setChannelLoad( i,
+                                        m_channelWorkers[ i ]->getMetrics(),
+                                        m_channels[ i ]->getBudgetPriority() );
+    }
+
+    m_budgetScheduler.schedule();
+
+    for ( const auto i : m_activeChannels )
+      m_channels[ i ]->setDegradeLevel( m_budgetScheduler.getLevel( i ) );
+  }
+
+  void MultichannelPipeline::scheduleParticleBudget()
+  {
+    // muted channels still spawn, so they get their share as well
+    int32_t totalWeight = 0;
+    uint64_t droppedCount = 0;
+    for ( const auto i : m_activeChannels )
+    {
+      totalWeight += m_channels[ i ]->getBudgetPriority() + 1;
+      droppedCount += m_channels[ i ]->getDroppedParticleCount();
+    }
+
+    for ( const auto i : m_activeChannels )
+    {
+      m_channels[ i ]->setParticleLimit(
+        m_particleBudget.getLimit( m_channels[ i ]->getBudgetPriority() + 1, totalWeight ) );
+    }
+
+    m_particleBudget.updateDroppedCount( droppedCount );
+  }
+
+  void MultichannelPipeline::drawSynchronized( sf::RenderWindow &window )
+  {
     // add a render update request and then start all the channel pipelines
-    for ( int i = 0; i < m_channels.size(); ++i )
+    for ( const auto i : m_activeChannels )
     {
+      // nothing would change, so the last output gets drawn again
+      // and there's nothing to wait on
+      if ( m_channels[ i ]->isIdle() )
+      {
+        m_channels[ i ]->skipFrame();
+        ++m_idleChannelCount;
+      }
+      // a muted channel still has to keep up with its events
+      else if ( m_channels[ i ]->isBypassed() )
+      {
+        m_channels[ i ]->requestSimulationUpdate();
+        m_channelWorkers[ i ]->requestPipelineRun();
+      }
+      else if ( m_budgetScheduler.shouldRender( i ) )
+      {
+        m_channels[ i ]->requestRenderUpdate();
+        m_channelWorkers[ i ]->requestPipelineRun();
+      }
+
       // skip the channel if it's bypassed
       if ( m_channels[ i ]->isBypassed() ) continue;
 
-      m_channels[ i ]->requestRenderUpdate();
-      m_channelWorkers[ i ]->requestPipelineRun();
-
       m_drawingPrioritizer.emplace( ChannelDrawingData_t
       {
         .priority = m_channels[ i ]->getDrawPriority(),
         .channel = m_channels[ i ].get(),
-        .channelWorker = m_channelWorkers[ i ].get()
+        .channelWorker = m_channelWorkers[ i ].get(),
+        .channelIndex = i
       } );
     }
 
@@ -117,8 +296,10 @@ namespace nx
       const auto * texture = top.channel->getOutputTexture();
       if ( texture != nullptr )
       {
+        GpuFence::waitOnGpu( top.channel->getOutputFence() );
         window.draw( sf::Sprite( texture->getTexture() ),
                      top.channel->getChannelBlendMode() );
+        top.channel->setConsumerFence( GpuFence::insert() );
       }
       // else
       // {
@@ -129,36 +310,162 @@ namespace nx
       m_drawingPrioritizer.pop();
     }
 
-    // now that we have a final image, send it to the video encoder
-    // and make sure we start at the right time
-    if ( m_encoder )
+    // the muted channels weren't waited on above
+    for ( const auto i : m_activeChannels )
     {
-      if ( m_encoder->isRecording() ) m_encoder->writeFrame( m_ctx.globalInfo.playhead, window );
-      else
+      if ( m_channels[ i ]->isBypassed() )
+        m_channelWorkers[ i ]->waitUntilComplete();
+    }
+  }
+
+  void MultichannelPipeline::drawPipelined( sf::RenderWindow &window )
+  {
+    m_frameWaitInMs = 0.0;
+
+    // a resize reallocates the channel textures, so everything gets redrawn right away
+    const bool hasResized = m_lastWindowSize != m_ctx.globalInfo.windowSize;
+    m_lastWindowSize = m_ctx.globalInfo.windowSize;
+
+    for ( const auto i : m_activeChannels )
+    {
+      if ( m_channels[ i ]->isBypassed() )
       {
-        m_messageClock.setMessage( "Encoder failed. NOT recording." );
-        m_encoder.reset( nullptr );
+        // nothing gets drawn, but it still has to keep up with its events
+        if ( m_frameStates[ i ].isInFlight ) collectChannel( i );
+        launchOrSkipChannel( i );
+        continue;
       }
+
+      m_drawingPrioritizer.emplace( ChannelDrawingData_t
+      {
+        .priority = m_channels[ i ]->getDrawPriority(),
+        .channel = m_channels[ i ].get(),
+        .channelWorker = m_channelWorkers[ i ].get(),
+        .channelIndex = i
+      } );
     }
 
-    // video encoding gets added whenever available,
-    // but there's no separate one right now for video encoding
-    // unless it becomes a problem
-    m_totalRenderAverage.stopTimerAndAddSample();
+    while ( !m_drawingPrioritizer.empty() )
+    {
+      const auto& top = m_drawingPrioritizer.top();
+      auto& state = m_frameStates[ top.channelIndex ];
+
+      if ( state.isInFlight )
+      {
+        // keep presenting the last output until the job is done
+        // or it falls too far behind
+        if ( hasResized ||
+             ++state.framesInFlight >= m_maxFramesInFlight ||
+             top.channelWorker->isPipelineComplete() )
+        {
+          collectChannel( top.channelIndex );
+        }
+      }
+
+      // nothing to show yet or the channel has changes queued up (e.g., shader deletions)
+      // that could invalidate the last output, so render it right now
+      if ( !state.isInFlight &&
+           ( state.output == nullptr || hasResized || top.channel->hasPendingTasks() ) )
+      {
+        launchChannel( top.channelIndex );
+        collectChannel( top.channelIndex );
+      }
+
+      if ( state.output != nullptr )
+      {
+        GpuFence::waitOnGpu( state.outputFence );
+        window.draw( sf::Sprite( state.output->getTexture() ),
+                     top.channel->getChannelBlendMode() );
+
+        // the next job renders into the other buffer, which was drawn here in
+        // earlier frames. the fence comes after those draws as well.
+        top.channel->setConsumerFence( GpuFence::insert() );
+      }
+
+      // the next frame renders into the back buffer while this one gets presented
+      if ( !state.isInFlight )
+        launchOrSkipChannel( top.channelIndex );
+
+      // must pop no matter what or an infinite loop will occur
+      m_drawingPrioritizer.pop();
+    }
+
+    m_waitAverage.addSample( m_frameWaitInMs );
+  }
+
+  void MultichannelPipeline::launchChannel( const int32_t channelIndex )
+  {
+    auto& state = m_frameStates[ channelIndex ];
+
+    if ( m_channels[ channelIndex ]->isBypassed() )
+      m_channels[ channelIndex ]->requestSimulationUpdate();
+    else
+      m_channels[ channelIndex ]->requestRenderUpdate();
+
+    m_channelWorkers[ channelIndex ]->requestPipelineRun();
+
+    state.isInFlight = true;
+    state.framesInFlight = 0;
+    state.launchTime = RingBufferAverager::Clock::now();
+  }
+
+  void MultichannelPipeline::launchOrSkipChannel( const int32_t channelIndex )
+  {
+    auto& channel = m_channels[ channelIndex ];
+    if ( channel->isIdle() )
+    {
+      channel->skipFrame();
+      ++m_idleChannelCount;
+    }
+    else if ( channel->isBypassed() || m_budgetScheduler.shouldRender( channelIndex ) )
+      launchChannel( channelIndex );
+  }
+
+  void MultichannelPipeline::collectChannel( const int32_t channelIndex )
+  {
+    auto& state = m_frameStates[ channelIndex ];
+    if ( !state.isInFlight ) return;
+
+    const auto waitStart = RingBufferAverager::Clock::now();
+    m_channelWorkers[ channelIndex ]->waitUntilComplete();
+    const auto now = RingBufferAverager::Clock::now();
+
+    m_frameWaitInMs += std::chrono::duration< double, std::milli >( now - waitStart ).count();
+    state.latencyAverage.addSample(
+      std::chrono::duration< double, std::milli >( now - state.launchTime ).count() );
+
+    state.output = m_channels[ channelIndex ]->getOutputTexture();
+    state.outputFence = m_channels[ channelIndex ]->getOutputFence();
+    state.isInFlight = false;
+    state.framesInFlight = 0;
+  }
+
+  void MultichannelPipeline::collectAllChannels()
+  {
+    for ( const auto i : m_activeChannels )
+      collectChannel( i );
   }
 
   void MultichannelPipeline::update( const sf::Time &deltaTime )
   {
     m_frameDiagnostics.update( deltaTime );
 
-    for ( const auto& channel: m_channels )
-      channel->update( deltaTime );
+#ifdef NX_RENDER_POOL
+    m_renderPool->sampleUtilization();
+#endif
+
+    // the channels simulate on their own threads as part of the next job,
+    // so this only hands over the time. a busy channel catches up next time.
+    for ( const auto i : m_activeChannels )
+      m_channels[ i ]->queueUpdate( deltaTime );
   }
 
-  void MultichannelPipeline::shutdown() const
+  void MultichannelPipeline::shutdown()
   {
     LOG_INFO( "Issuing shutdown requests..." );
-    for ( int i = 0; i < m_channels.size(); ++i )
+    collectAllChannels();
+
+    for ( const auto i : m_activeChannels )
     {
       m_channels[ i ]->requestShutdown();
       m_channelWorkers[ i ]->requestPipelineRun();
@@ -204,11 +511,30 @@ namespace nx
 
     ImGui::Separator();
 
-    m_channels[ m_selectedChannel ]->drawMenu();
+    if ( m_channels[ m_selectedChannel ] )
+    {
+      // the menu works directly on the channel, so it can't be rendering
+      collectChannel( m_selectedChannel );
+      m_channels[ m_selectedChannel ]->drawMenu();
+
+      // settings may have changed, so an idle channel can't just reuse its output
+      if ( ImGui::IsWindowHovered( ImGuiHoveredFlags_RootAndChildWindows ) ||
+           ImGui::IsAnyItemActive() )
+      {
+        m_channels[ m_selectedChannel ]->markDirty();
+      }
+    }
+    else
+    {
+      ImGui::TextDisabled( "Channel is not in use" );
+      if ( ImGui::Button( "Enable Channel" ) )
+        activateChannel( m_selectedChannel );
+    }
 
     ImGui::Separator();
     if ( ImGui::Button( "export" ) )
     {
+      collectAllChannels();
       const auto json = saveState();
       ImGui::SetClipboardText( json.dump().c_str() );
       m_messageClock.setMessage( "data copied to clipboard." );
@@ -298,7 +624,7 @@ namespace nx
 
       ImGui::SeparatorText( "Render Times (Avg)" );
 
-      for ( int32_t i = 0; i < m_channelWorkers.size(); ++i )
+      for ( const auto i : m_activeChannels )
       {
         const auto metrics = m_channelWorkers[ i ]->getMetrics();
         if ( i == AUDIO_CHANNEL_INDEX )
@@ -311,9 +637,97 @@ namespace nx
       ImGui::Text( "Cycle Time: %0.2f ms", m_totalRenderAverage.getCycleTimeInMs() );
       ImGui::Text( "Cycle Size: %d samples", RENDER_SAMPLES_COUNT );
 
+      // should stay flat once everything is running
+      size_t heapTaskCount = 0;
+      size_t overflowTaskCount = 0;
+      for ( const auto i : m_activeChannels )
+      {
+        heapTaskCount += m_channels[ i ]->getHeapTaskCount();
+        overflowTaskCount += m_channels[ i ]->getOverflowTaskCount();
+      }
+
+      ImGui::Text( "Heap-Allocated Tasks: %zu", heapTaskCount );
+      ImGui::Text( "Task Queue Overflows: %zu", overflowTaskCount );
+      ImGui::Text( "Idle Channels: %d / %zu", m_idleChannelCount, m_activeChannels.size() );
+      ImGui::Text( "GPU Fence Waits: %zu", GpuFence::getWaitCount() );
+
+      ImGui::SeparatorText( "Particle Pools (Peak)" );
+
+      for ( const auto i : m_activeChannels )
+      {
+        const auto& pool = m_channels[ i ]->getParticlePool();
+        for ( size_t sizeClass = 0; sizeClass < pool.getSizeClassCount(); ++sizeClass )
+        {
+          const auto stats = pool.getStats( sizeClass );
+          ImGui::Text( "Channel %d, %zu B: %zu live, %zu peak, %zu reserved",
+                       i, stats.size, stats.liveCount, stats.highWaterCount, stats.reservedCount );
+        }
+
+        if ( const auto fallbackCount = pool.getHeapFallbackCount(); fallbackCount > 0 )
+          ImGui::Text( "Channel %d: %zu heap fallbacks", i, fallbackCount );
+      }
+
+      ImGui::SeparatorText( "Frame Budget" );
+
+      m_budgetScheduler.drawMenu();
+
+      if ( m_budgetScheduler.isEnabled() )
+      {
+        bool hasDegraded = false;
+        for ( const auto i : m_activeChannels )
+        {
+          if ( !m_budgetScheduler.wasRecentlyDegraded( i ) ) continue;
+
+          hasDegraded = true;
+          ImGui::Text( "Channel %d: %s",
+                       i,
+                       FrameBudgetScheduler::getLevelName( m_budgetScheduler.getLevel( i ) ) );
+        }
+
+        if ( !hasDegraded )
+          ImGui::TextDisabled( "No degraded channels" );
+      }
+
+      ImGui::SeparatorText( "Particle Budget" );
+
+      m_particleBudget.drawMenu();
+
+      ImGui::SeparatorText( "Pipelining" );
+
+      // hand everything back to the synchronized path when it gets turned off
+      if ( ImGui::Checkbox( "Pipelined Frames", &m_isPipelined ) && !m_isPipelined )
+        collectAllChannels();
+
+      if ( m_isPipelined )
+      {
+        ImGui::SliderInt( "Max Frames In Flight", &m_maxFramesInFlight, 1, 3 );
+
+        for ( const auto i : m_activeChannels )
+        {
+          const auto& latency = m_frameStates[ i ].latencyAverage;
+          const auto cycleTimeInMs = latency.getCycleTimeInMs();
+          const auto throughput = cycleTimeInMs > 0.0
+            ? RENDER_SAMPLES_COUNT * 1000.0 / cycleTimeInMs
+            : 0.0;
+
+          ImGui::Text( "Channel %d: %0.2f ms latency, %0.1f frames/s",
+                       i, latency.getAverage(), throughput );
+        }
+
+        ImGui::Text( "Main Thread Wait: %0.2f ms", m_waitAverage.getAverage() );
+      }
+
+#ifdef NX_RENDER_POOL
+      ImGui::SeparatorText( "Render Pool (Avg)" );
+
+      for ( size_t i = 0; i < m_renderPool->getWorkerCount(); ++i )
+        ImGui::Text( "Worker %zu: %0.1f%%", i, m_renderPool->getUtilization( i ) );
+#endif
+
       ImGui::SeparatorText( "Audio Buffer (Avg)" );
 
       ImGui::Text( "Buffer age: %0.2f ms", m_audioDataAverage.getAverage() );
+      ImGui::Text( "Dropped FFT frames: %llu", static_cast< unsigned long long >( m_droppedAudioFrameCount ) );
 
       m_frameDiagnostics.drawMenu();
     }
@@ -321,4 +735,4 @@ namespace nx
     ImGui::End();
   }
 
-} // namespace nx
+} // namespace nx
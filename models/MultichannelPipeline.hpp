@@ -22,8 +22,11 @@
 #include "data/PipelineContext.hpp"
 #include "helpers/Definitions.hpp"
 #include "models/encoder/EncoderFactory.hpp"
+#include "models/ParticleBudget.hpp"
 #include "shapes/TimedMessage.hpp"
+#include "utils/AtomicChannelWorker.hpp"
 #include "utils/ChannelWorker.hpp"
+#include "utils/PooledChannelWorker.hpp"
 #include "utils/ImGuiFrameDiagnostics.hpp"
 
 #ifdef BUILD_PLUGIN
@@ -43,7 +46,8 @@ namespace nx
     {
       int32_t priority { 0 };
       ChannelPipeline * channel { nullptr };
-      ChannelWorker * channelWorker { nullptr };
+      IChannelWorker * channelWorker { nullptr };
+      int32_t channelIndex { 0 };
 
       // Overload '<' for std::priority_queue (max-heap)
       // Lower priority value = higher actual priority
@@ -58,15 +62,33 @@ namespace nx
       }
     };
 
+    // bookkeeping for a channel when frames are pipelined. the channel queues up
+    // whatever arrives while a job is in flight and hands it all to the next one.
+    struct ChannelFrameState_t
+    {
+      bool isInFlight { false };
+
+      // number of presented frames since the render job was launched
+      int32_t framesInFlight { 0 };
+
+      // the last completed output, which is safe to composite while the
+      // worker renders the next one into the back buffer
+      sf::RenderTexture * output { nullptr };
+      GpuFence::Sync outputFence { nullptr };
+
+      RingBufferAverager::TimePoint launchTime;
+      RingBufferAverager latencyAverage { RENDER_SAMPLES_COUNT };
+    };
+
   public:
     explicit MultichannelPipeline( PipelineContext& context );
     ~MultichannelPipeline() = default;
 
     [[nodiscard]]
     nlohmann::json saveState() const;
-    void restoreState( const nlohmann::json &j ) const;
+    void restoreState( const nlohmann::json &j );
 
-    void processMidiEvent( const Midi_t &midi ) const;
+    void processMidiEvent( const Midi_t &midi );
     void processAudioData( FFTBuffer& buffer );
 
     void draw(sf::RenderWindow &window);
@@ -74,10 +96,36 @@ namespace nx
 
     void update(const sf::Time &deltaTime);
 
-    void shutdown() const;
+    void shutdown();
 
   private:
 
+    // sets up the channel pipeline and its worker the first time it's needed
+    void activateChannel( int32_t channelIndex );
+
+    // tears the channel pipeline and its worker down again
+    void deactivateChannel( int32_t channelIndex );
+
+    [[nodiscard]]
+    std::unique_ptr< IChannelWorker > createChannelWorker( int32_t channelIndex );
+
+    // hands the channels their quality level for this frame
+    void scheduleFrameBudget();
+    void scheduleParticleBudget();
+
+    void drawSynchronized( sf::RenderWindow &window );
+    void drawPipelined( sf::RenderWindow &window );
+
+    // starts rendering the next frame on the channel worker
+    void launchChannel( int32_t channelIndex );
+
+    // same as above unless the channel is idle or the frame budget says otherwise
+    void launchOrSkipChannel( int32_t channelIndex );
+
+    // blocks until the in-flight render job is done and keeps its output
+    void collectChannel( int32_t channelIndex );
+    void collectAllChannels();
+
     void drawPipelineMenu();
     void drawPipelineMetrics();
 
@@ -85,8 +133,17 @@ namespace nx
 
     PipelineContext m_ctx;
 
+#ifdef NX_RENDER_POOL
+    // must outlive the channels and their workers
+    std::unique_ptr< WorkStealingPool > m_renderPool;
+#endif
+
+    // channels are null until they're activated
     std::array< std::unique_ptr< ChannelPipeline >, MAX_CHANNELS > m_channels;
-    std::array< std::unique_ptr< ChannelWorker >, MAX_CHANNELS > m_channelWorkers;
+    std::array< std::unique_ptr< IChannelWorker >, MAX_CHANNELS > m_channelWorkers;
+
+    // indices of the channels that have been set up, in ascending order
+    std::vector< int32_t > m_activeChannels;
 
     TimedMessage m_messageClock;
 
@@ -109,9 +166,26 @@ namespace nx
     float m_metricsWindowOpacity { 0.3f };
 
     RingBufferAverager m_audioDataAverage { RENDER_SAMPLES_COUNT };
+    uint64_t m_droppedAudioFrameCount { 0 };
+
+    // channel workers render the next frame while the current one is presented
+    bool m_isPipelined { false };
+    int32_t m_maxFramesInFlight { 1 };
+    std::array< ChannelFrameState_t, MAX_CHANNELS > m_frameStates;
+    sf::Vector2u m_lastWindowSize;
+
+    // time the main thread spends blocked on channel workers
+    RingBufferAverager m_waitAverage { RENDER_SAMPLES_COUNT };
+    double m_frameWaitInMs { 0.0 };
+
+    FrameBudgetScheduler m_budgetScheduler;
+    ParticleBudget m_particleBudget;
+
+    // channels that reused their last output this frame
+    int32_t m_idleChannelCount { 0 };
 
     static constexpr int32_t AUDIO_CHANNEL_INDEX = 0;
     static constexpr int32_t MIDI_CHANNEL_INDEX = 1;
   };
 
-} // namespace nx
+} // namespace nx
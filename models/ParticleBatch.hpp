@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include "helpers/ColorFadeKernel.hpp"
+#include "models/IParticle.hpp"
+#include "models/particle/particles/UnitCircleTable.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Collects particles as one list of transformed triangles, so drawing all of
+  /// them is a single draw call instead of one or two per particle. The particles
+  /// add themselves through IParticle::appendTo.
+  ///
+  /// The vertices keep their capacity between frames, so this doesn't allocate
+  /// once the particle count has settled.
+  ///
+  /// Shapes can be given a fade, which is how far they are along fading to black.
+  /// It travels in the texture coordinates and a small shader applies it, so
+  /// particles that fade this way never get their colors rewritten.
+  class ParticleBatch final : public sf::Drawable
+  {
+  public:
+
+    // for drawing a single particle outside of a batch
+    static void drawParticle( const IParticle& particle,
+                              sf::RenderTarget& target,
+                              const sf::RenderStates& states )
+    {
+      thread_local ParticleBatch batch;
+
+      batch.clear();
+      particle.appendTo( batch );
+      target.draw( batch, states );
+    }
+
+    void clear()
+    {
+      m_vertices.clear();
+      m_hasFade = false;
+    }
+
+    [[nodiscard]]
+    bool empty() const { return m_vertices.empty(); }
+
+    [[nodiscard]]
+    size_t getVertexCount() const { return m_vertices.size(); }
+
+    // a filled polygon around origin, fanned out from the center of its bounds
+    void appendDisc( const UnitCircle_t& circle,
+                     const sf::Transform& transform,
+                     const sf::Vector2f origin,
+                     const float radius,
+                     const std::pair< sf::Color, sf::Color >& colors,
+                     const float fade = 0.f )
+    {
+      const auto pointCount = static_cast< int32_t >( circle.directions.size() ) - 1;
+      if ( pointCount < 3 ) return;
+
+      const auto vertexColors = getGradient( circle.fanWeights, colors );
+      setFade( fade );
+
+      const auto center = makeVertex(
+        transform, origin + circle.bounds.getCenter() * radius, vertexColors[ 0 ] );
+
+      auto previous = makeVertex(
+        transform, origin + circle.directions[ 0 ] * radius, vertexColors[ 1 ] );
+
+      for ( int32_t i = 1; i <= pointCount; ++i )
+      {
+        const auto current = makeVertex(
+          transform, origin + circle.directions[ i ] * radius, vertexColors[ i + 1 ] );
+
+        m_vertices.push_back( center );
+        m_vertices.push_back( previous );
+        m_vertices.push_back( current );
+        previous = current;
+      }
+    }
+
+    // the strip between two radii around origin, e.g., an outline or a ring
+    void appendBand( const UnitCircle_t& circle,
+                     const sf::Transform& transform,
+                     const sf::Vector2f origin,
+                     const float firstRadius,
+                     const float secondRadius,
+                     const std::pair< sf::Color, sf::Color >& colors,
+                     const float fade = 0.f )
+    {
+      const auto pointCount = static_cast< int32_t >( circle.directions.size() ) - 1;
+      if ( pointCount < 1 ) return;
+
+      const auto vertexColors = getGradient( circle.bandWeights, colors );
+      setFade( fade );
+
+      auto first = makeVertex(
+        transform, origin + circle.directions[ 0 ] * firstRadius, vertexColors[ 0 ] );
+      auto second = makeVertex(
+        transform, origin + circle.directions[ 0 ] * secondRadius, vertexColors[ 1 ] );
+
+      for ( int32_t i = 1; i <= pointCount; ++i )
+      {
+        const auto nextFirst = makeVertex(
+          transform, origin + circle.directions[ i ] * firstRadius, vertexColors[ i * 2 ] );
+        const auto nextSecond = makeVertex(
+          transform, origin + circle.directions[ i ] * secondRadius, vertexColors[ i * 2 + 1 ] );
+
+        m_vertices.push_back( first );
+        m_vertices.push_back( second );
+        m_vertices.push_back( nextFirst );
+
+        m_vertices.push_back( second );
+        m_vertices.push_back( nextFirst );
+        m_vertices.push_back( nextSecond );
+
+        first = nextFirst;
+        second = nextSecond;
+      }
+    }
+
+  protected:
+
+    void draw( sf::RenderTarget& target, sf::RenderStates states ) const override
+    {
+      if ( m_vertices.empty() ) return;
+
+      if ( m_hasFade )
+        states.shader = m_fadeShader.get();
+
+      target.draw( m_vertices.data(), m_vertices.size(), sf::PrimitiveType::Triangles, states );
+    }
+
+  private:
+
+    // the colors of all the vertices of one shape, valid until the next call.
+    // particles that fade in the shader share their colors, so this is mostly a lookup.
+    std::span< const sf::Color > getGradient( const std::vector< float >& weights,
+                                              const std::pair< sf::Color, sf::Color >& colors )
+    {
+      if ( &weights != m_gradientWeights || colors != m_gradientColors )
+      {
+        if ( m_gradient.size() < weights.size() )
+          m_gradient.resize( weights.size() );
+
+        ColorFadeKernel::fade( colors.first, colors.second, weights, m_gradient );
+        m_gradientWeights = &weights;
+        m_gradientColors = colors;
+      }
+
+      return { m_gradient.data(), weights.size() };
+    }
+
+    void setFade( const float fade )
+    {
+      m_fade = fade;
+      if ( fade <= 0.f || m_hasFade ) return;
+
+      if ( !m_fadeShader )
+      {
+        m_fadeShader = std::make_unique< sf::Shader >();
+        if ( !m_fadeShader->loadFromMemory( m_fragmentShader, sf::Shader::Type::Fragment ) )
+          LOG_ERROR( "Failed to load particle fade fragment shader" );
+      }
+
+      m_hasFade = true;
+    }
+
+    sf::Vertex makeVertex( const sf::Transform& transform,
+                           const sf::Vector2f position,
+                           const sf::Color color ) const
+    {
+      return sf::Vertex { transform.transformPoint( position ), color, { m_fade, 0.f } };
+    }
+
+  private:
+
+    std::vector< sf::Vertex > m_vertices;
+
+    std::vector< sf::Color > m_gradient;
+    const std::vector< float > * m_gradientWeights { nullptr };
+    std::pair< sf::Color, sf::Color > m_gradientColors;
+
+    // the fade of the shape being appended
+    float m_fade { 0.f };
+    bool m_hasFade { false };
+    std::unique_ptr< sf::Shader > m_fadeShader;
+
+    // fades toward black, the same as the layouts do on the cpu
+    const static inline std::string m_fragmentShader = R"(
+void main()
+{
+    float fade = clamp(gl_TexCoord[0].x, 0.0, 1.0);
+    gl_FragColor = vec4(gl_Color.rgb * (1.0 - fade), mix(gl_Color.a, 1.0, fade));
+}
+)";
+  };
+
+}
@@ -80,12 +80,14 @@ namespace nx
       behavior->applyOnSpawn( p, particleData );
   }
 
-  void ParticleBehaviorPipeline::applyOnUpdate( IParticle * p,
+  void ParticleBehaviorPipeline::applyOnUpdate( const ParticleFields_t& fields,
                                                 const sf::Time& deltaTime,
                                                 const ParticleData_t& particleData ) const
   {
+    if ( fields.empty() ) return;
+
     for ( const auto& behavior : m_particleBehaviors )
-      behavior->applyOnUpdate( p, deltaTime, particleData );
+      behavior->applyOnUpdate( fields, deltaTime, particleData );
   }
 
   void ParticleBehaviorPipeline::drawMenu()
@@ -36,7 +36,8 @@ namespace nx
     void applyOnSpawn( IParticle * p,
                        const ParticleData_t& particleData ) const;
 
-    void applyOnUpdate( IParticle * p,
+    // runs every behavior over all the particles, one behavior at a time
+    void applyOnUpdate( const ParticleFields_t& fields,
                         const sf::Time& deltaTime,
                         const ParticleData_t& particleData ) const;
 
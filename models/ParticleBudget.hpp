@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include "helpers/Definitions.hpp"
+#include "utils/RingBufferAverager.hpp"
+
+#include "models/data/ParticleLimit_t.hpp"
+
+namespace nx
+{
+
+  ///
+  /// A cap on the particles of all channels together, so a note burst or a loud
+  /// passage can't pile up particles until the frame rate goes. The budget is
+  /// split between the channels by weight and each channel enforces its share.
+  class ParticleBudget final
+  {
+    using Clock = RingBufferAverager::Clock;
+    using TimePoint = RingBufferAverager::TimePoint;
+
+  public:
+
+    [[nodiscard]]
+    bool isEnabled() const { return m_isEnabled; }
+
+    // the share of a channel. no limit when the budget is off.
+    [[nodiscard]]
+    ParticleLimit_t getLimit( const int32_t weight, const int32_t totalWeight ) const
+    {
+      if ( !m_isEnabled || totalWeight <= 0 ) return {};
+
+      const auto share = static_cast< size_t >( m_maxParticles ) *
+                         static_cast< size_t >( weight ) /
+                         static_cast< size_t >( totalWeight );
+
+      return { std::max< size_t >( share, 1 ), m_policy };
+    }
+
+    // called every frame with the running total of all the channels
+    void updateDroppedCount( const uint64_t droppedCount )
+    {
+      const auto now = Clock::now();
+      const std::chrono::duration< double > elapsed = now - m_lastSampleTime;
+      if ( elapsed < SAMPLE_INTERVAL ) return;
+
+      // the total goes down when a channel goes away
+      const auto droppedSinceLast = droppedCount >= m_lastDroppedCount
+        ? droppedCount - m_lastDroppedCount
+        : 0;
+
+      m_droppedPerSecond = static_cast< double >( droppedSinceLast ) / elapsed.count();
+      m_lastDroppedCount = droppedCount;
+      m_lastSampleTime = now;
+    }
+
+    [[nodiscard]]
+    nlohmann::json serialize() const
+    {
+      return
+      {
+        { "isEnabled", m_isEnabled },
+        { "maxParticles", m_maxParticles },
+        { "policy", m_policy == E_ParticleLimitPolicy::E_ThinSpawns ? "thinSpawns" : "evictOldest" }
+      };
+    }
+
+    void deserialize( const nlohmann::json& j )
+    {
+      m_isEnabled = j.value( "isEnabled", false );
+      m_maxParticles = std::clamp( j.value( "maxParticles", DEFAULT_MAX_PARTICLES ), MIN_PARTICLES, MAX_PARTICLES );
+      m_policy = j.value( "policy", "evictOldest" ) == "thinSpawns"
+        ? E_ParticleLimitPolicy::E_ThinSpawns
+        : E_ParticleLimitPolicy::E_EvictOldest;
+    }
+
+    void drawMenu()
+    {
+      ImGui::Checkbox( "Particle Budget", &m_isEnabled );
+      ImGui::SliderInt( "Max Particles", &m_maxParticles, MIN_PARTICLES, MAX_PARTICLES );
+
+      int32_t policy = static_cast< int32_t >( m_policy );
+      ImGui::RadioButton( "Evict Oldest", &policy, static_cast< int32_t >( E_ParticleLimitPolicy::E_EvictOldest ) );
+      ImGui::SameLine();
+      ImGui::RadioButton( "Thin Spawns", &policy, static_cast< int32_t >( E_ParticleLimitPolicy::E_ThinSpawns ) );
+      m_policy = static_cast< E_ParticleLimitPolicy >( policy );
+
+      ImGui::Text( "Particles Evicted: %0.0f/s", m_droppedPerSecond );
+    }
+
+  private:
+
+    bool m_isEnabled { false };
+    int32_t m_maxParticles { DEFAULT_MAX_PARTICLES };
+    E_ParticleLimitPolicy m_policy { E_ParticleLimitPolicy::E_EvictOldest };
+
+    uint64_t m_lastDroppedCount { 0 };
+    TimePoint m_lastSampleTime { Clock::now() };
+    double m_droppedPerSecond { 0.0 };
+
+    static constexpr auto SAMPLE_INTERVAL = std::chrono::seconds( 1 );
+
+    static constexpr int32_t DEFAULT_MAX_PARTICLES = 20000;
+    static constexpr int32_t MIN_PARTICLES = 1000;
+    static constexpr int32_t MAX_PARTICLES = 100000;
+  };
+
+}
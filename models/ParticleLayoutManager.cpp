@@ -59,7 +59,7 @@ namespace nx
     m_particleLayout->processAudioBuffer( fftResult );
   }
 
-  std::deque< IParticle* >& ParticleLayoutManager::getParticles() const
+  ParticleSpan ParticleLayoutManager::getParticles() const
   {
     return m_particleLayout->getParticles();
   }
@@ -118,4 +118,4 @@ namespace nx
     m_particleLayout->drawMenu();
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
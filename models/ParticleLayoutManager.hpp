@@ -41,7 +41,12 @@ namespace nx
     void processAudioBuffer( const IFFTResult& fftResult ) const;
 
     [[nodiscard]]
-    std::deque< IParticle* >& getParticles() const;
+    ParticleSpan getParticles() const;
+
+    void setParticleLimit( const ParticleLimit_t& limit ) const { m_particleLayout->setParticleLimit( limit ); }
+
+    [[nodiscard]]
+    size_t takeDroppedParticleCount() const { return m_particleLayout->takeDroppedParticleCount(); }
 
     void drawAudioMenu();
 
@@ -74,4 +79,4 @@ namespace nx
     nlohmann::json m_tempSettings;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
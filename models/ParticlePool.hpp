@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace nx
+{
+
+  ///
+  /// Recycles the particle memory of a channel, so spawning and expiring particles
+  /// doesn't touch the global heap once it's warmed up. Memory is carved out of
+  /// slabs and kept on a free list per allocation size. Particle types of the same
+  /// size share a size class, which is fine since the blocks are interchangeable.
+  /// Sizes beyond the last class come from the heap and get counted as fallbacks.
+  ///
+  /// The particles don't know about the pool. Their operator new uses the pool
+  /// of the current thread (see Scope), and operator delete returns the memory
+  /// to the pool it came from, no matter which thread deletes it. Anything
+  /// allocated without a pool in scope comes from the heap as usual.
+  class ParticlePool final
+  {
+    // sits in front of every particle
+    struct alignas( std::max_align_t ) BlockHeader_t
+    {
+      ParticlePool * owner { nullptr };
+      int32_t sizeClass { -1 };
+    };
+
+    struct FreeBlock_t
+    {
+      FreeBlock_t * next { nullptr };
+    };
+
+  public:
+
+    struct SizeClassStats_t
+    {
+      size_t size { 0 };
+      size_t liveCount { 0 };
+      size_t highWaterCount { 0 };
+      size_t reservedCount { 0 };
+    };
+
+    // particles created on this thread come out of the pool until it goes out of scope
+    class Scope final
+    {
+    public:
+      explicit Scope( ParticlePool * pool )
+        : m_previousPool( t_currentPool )
+      {
+        t_currentPool = pool;
+      }
+
+      ~Scope() { t_currentPool = m_previousPool; }
+
+      Scope( const Scope& ) = delete;
+      Scope& operator=( const Scope& ) = delete;
+
+    private:
+      ParticlePool * m_previousPool;
+    };
+
+    ParticlePool() = default;
+
+    ParticlePool( const ParticlePool& ) = delete;
+    ParticlePool& operator=( const ParticlePool& ) = delete;
+
+    ~ParticlePool()
+    {
+      for ( size_t i = 0; i < m_sizeClassCount; ++i )
+      {
+        if ( m_sizeClasses[ i ].stats.liveCount > 0 )
+        {
+          LOG_ERROR( "particle pool destroyed with {} live blocks of {} bytes",
+                     m_sizeClasses[ i ].stats.liveCount,
+                     m_sizeClasses[ i ].stats.size );
+        }
+      }
+
+      for ( auto * slab : m_slabs )
+        ::operator delete( slab );
+    }
+
+    [[nodiscard]]
+    static ParticlePool * getCurrent() { return t_currentPool; }
+
+    // used by the particles' operator new
+    [[nodiscard]]
+    static void * allocate( const size_t size )
+    {
+      BlockHeader_t * header = nullptr;
+
+      if ( auto * pool = t_currentPool )
+        header = pool->acquire( size );
+      else
+        header = new ( ::operator new( sizeof( BlockHeader_t ) + size ) ) BlockHeader_t {};
+
+      return header + 1;
+    }
+
+    // used by the particles' operator delete
+    static void deallocate( void * memory )
+    {
+      if ( memory == nullptr ) return;
+
+      auto * header = static_cast< BlockHeader_t * >( memory ) - 1;
+      if ( header->owner != nullptr )
+        header->owner->release( header );
+      else
+        ::operator delete( header );
+    }
+
+    [[nodiscard]]
+    size_t getSizeClassCount() const
+    {
+      std::lock_guard lock( m_mutex );
+      return m_sizeClassCount;
+    }
+
+    [[nodiscard]]
+    SizeClassStats_t getStats( const size_t sizeClass ) const
+    {
+      std::lock_guard lock( m_mutex );
+      return m_sizeClasses[ sizeClass ].stats;
+    }
+
+    // allocations that went to the heap because every size class was taken
+    [[nodiscard]]
+    size_t getHeapFallbackCount() const
+    {
+      std::lock_guard lock( m_mutex );
+      return m_heapFallbackCount;
+    }
+
+  private:
+
+    struct SizeClass_t
+    {
+      SizeClassStats_t stats;
+      FreeBlock_t * freeList { nullptr };
+    };
+
+    BlockHeader_t * acquire( const size_t size )
+    {
+      std::lock_guard lock( m_mutex );
+
+      const auto sizeClass = findSizeClass( size );
+      if ( sizeClass < 0 )
+      {
+        // there are only a handful of particle sizes, so this shouldn't happen
+        if ( m_heapFallbackCount++ == 0 )
+          LOG_WARN( "particle pool is out of size classes, {} byte particles come from the heap", size );
+
+        return new ( ::operator new( sizeof( BlockHeader_t ) + size ) ) BlockHeader_t {};
+      }
+
+      auto& entry = m_sizeClasses[ sizeClass ];
+      if ( entry.freeList == nullptr )
+        addSlab( entry );
+
+      auto * block = entry.freeList;
+      entry.freeList = block->next;
+
+      auto& stats = entry.stats;
+      stats.highWaterCount = std::max( stats.highWaterCount, ++stats.liveCount );
+
+      return new ( block ) BlockHeader_t { this, sizeClass };
+    }
+
+    void release( BlockHeader_t * header )
+    {
+      std::lock_guard lock( m_mutex );
+
+      auto& entry = m_sizeClasses[ header->sizeClass ];
+      --entry.stats.liveCount;
+
+      auto * block = new ( header ) FreeBlock_t { entry.freeList };
+      entry.freeList = block;
+    }
+
+    int32_t findSizeClass( const size_t size )
+    {
+      for ( size_t i = 0; i < m_sizeClassCount; ++i )
+      {
+        if ( m_sizeClasses[ i ].stats.size == size )
+          return static_cast< int32_t >( i );
+      }
+
+      if ( m_sizeClassCount == m_sizeClasses.size() ) return -1;
+
+      m_sizeClasses[ m_sizeClassCount ].stats.size = size;
+      return static_cast< int32_t >( m_sizeClassCount++ );
+    }
+
+    void addSlab( SizeClass_t& entry )
+    {
+      const size_t blockSize = getBlockSize( entry.stats.size );
+      auto * slab = static_cast< std::byte * >( ::operator new( blockSize * SLAB_BLOCK_COUNT ) );
+      m_slabs.push_back( slab );
+
+      for ( size_t i = 0; i < SLAB_BLOCK_COUNT; ++i )
+        entry.freeList = new ( slab + i * blockSize ) FreeBlock_t { entry.freeList };
+
+      entry.stats.reservedCount += SLAB_BLOCK_COUNT;
+    }
+
+    static constexpr size_t getBlockSize( const size_t size )
+    {
+      constexpr size_t alignment = alignof( BlockHeader_t );
+      return ( sizeof( BlockHeader_t ) + size + alignment - 1 ) / alignment * alignment;
+    }
+
+  private:
+
+    static constexpr size_t MAX_SIZE_CLASSES = 8;
+
+    mutable std::mutex m_mutex;
+
+    std::array< SizeClass_t, MAX_SIZE_CLASSES > m_sizeClasses;
+    size_t m_sizeClassCount { 0 };
+    size_t m_heapFallbackCount { 0 };
+
+    std::vector< std::byte * > m_slabs;
+
+    static constexpr size_t SLAB_BLOCK_COUNT = 256;
+
+    inline static thread_local ParticlePool * t_currentPool { nullptr };
+  };
+
+}
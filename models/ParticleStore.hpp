@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "models/IParticle.hpp"
+#include "models/data/ParticleFields_t.hpp"
+#include "models/data/ParticleLimit_t.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Owns the particles of a layout in spawn order, as a structure of arrays. The
+  /// particle pointers sit in one contiguous array that everything downstream
+  /// iterates as a ParticleSpan. The simulated state lives in arrays of its own:
+  /// positions, spawn and expiration times, clocks, life percentages and energies.
+  ///
+  /// A new particle is set up through IParticle as usual. The store takes its state
+  /// over at the next update, and from then on the clocks and the behaviors only work
+  /// on the arrays (see ParticleFields_t). syncParticles() writes the positions and
+  /// clocks back, so the modifiers and the batch see them on the particles.
+  ///
+  /// The particles of a layout share their lifetime, so they expire in the order
+  /// they were spawned. The arrays work as a FIFO: expired particles are dropped
+  /// by moving the head past them, and the space in front of the head is only
+  /// reclaimed once it's half the array. A single compacting pass takes over for
+  /// the frames in which something expired out of order (e.g., a behavior
+  /// changed a lifetime). Either way the order is kept, because the line
+  /// modifiers connect the particles in the order they were spawned. Every array
+  /// shares the head, so they all move together.
+  ///
+  /// The store also enforces the particle limit of its channel, either by evicting
+  /// the oldest particles or by turning new ones away (see ParticleLimit_t).
+  class ParticleStore final
+  {
+  public:
+    ParticleStore() = default;
+
+    ParticleStore( const ParticleStore& ) = delete;
+    ParticleStore& operator=( const ParticleStore& ) = delete;
+
+    ~ParticleStore() { clear(); }
+
+    // asked by the layouts before they create a particle, so a spawn that gets
+    // thinned out never allocates anything. a refused spawn counts as dropped.
+    [[nodiscard]]
+    bool canSpawn()
+    {
+      if ( !shouldThin() ) return true;
+
+      ++m_droppedCount;
+      return false;
+    }
+
+    // takes ownership of the particle. ask canSpawn first, so the limit gets a say.
+    // the particle can still be set up until the next update takes its state over.
+    IParticle * add( IParticle * particle )
+    {
+      m_particles.push_back( particle );
+      m_positionsX.push_back( 0.f );
+      m_positionsY.push_back( 0.f );
+      m_spawnTimes.push_back( 0.f );
+      m_expirationTimes.push_back( 0.f );
+      m_timesAlive.push_back( 0.f );
+      m_lifePercentages.push_back( 0.f );
+      m_energies.push_back( 0.f );
+      return particle;
+    }
+
+    // advances the particle clocks and deletes the particles that expired
+    void update( const sf::Time& deltaTime )
+    {
+      takeOverSpawned();
+
+      const auto count = size();
+      const float seconds = deltaTime.asSeconds();
+
+      float * timesAlive = m_timesAlive.data() + m_head;
+      float * lifePercentages = m_lifePercentages.data() + m_head;
+      const float * spawnTimes = m_spawnTimes.data() + m_head;
+      const float * expirationTimes = m_expirationTimes.data() + m_head;
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+        timesAlive[ i ] += seconds;
+        lifePercentages[ i ] = timesAlive[ i ] / ( expirationTimes[ i ] - spawnTimes[ i ] );
+      }
+
+      size_t expiredCount = 0;
+      while ( expiredCount < count && lifePercentages[ expiredCount ] >= 1.f )
+        ++expiredCount;
+
+      const bool isInOrder = std::none_of(
+        lifePercentages + expiredCount,
+        lifePercentages + count,
+        []( const float percentage ) { return percentage >= 1.f; } );
+
+      if ( isInOrder )
+        popFront( expiredCount );
+      else
+        removeExpired();
+
+      if ( m_limit.policy == E_ParticleLimitPolicy::E_EvictOldest &&
+           m_limit.maxCount > 0 &&
+           size() > m_limit.maxCount )
+      {
+        const auto evictCount = size() - m_limit.maxCount;
+        popFront( evictCount );
+        m_droppedCount += evictCount;
+      }
+    }
+
+    // hands the simulated positions and clocks to the particles. call this once the
+    // behaviors are done, so that the modifiers and the batch draw the latest state.
+    void syncParticles()
+    {
+      for ( size_t i = m_head; i < m_particles.size(); ++i )
+      {
+        m_particles[ i ]->setPosition( { m_positionsX[ i ], m_positionsY[ i ] } );
+        m_particles[ i ]->setTimeAliveInSeconds( m_timesAlive[ i ] );
+      }
+    }
+
+    void clear()
+    {
+      for ( size_t i = m_head; i < m_particles.size(); ++i )
+        delete m_particles[ i ];
+
+      forEachArray( []( auto& array ) { array.clear(); } );
+      m_head = 0;
+      m_spawnedFrom = 0;
+    }
+
+    // applies from the next spawn or update on
+    void setLimit( const ParticleLimit_t& limit ) { m_limit = limit; }
+
+    // the particles evicted or thinned out since the last call
+    [[nodiscard]]
+    size_t takeDroppedCount() { return std::exchange( m_droppedCount, 0 ); }
+
+    // the arrays of the live particles. only valid until the next add or update.
+    [[nodiscard]]
+    ParticleFields_t getFields()
+    {
+      const auto count = size();
+      return
+      {
+        .particles = getSpan(),
+        .positionsX = { m_positionsX.data() + m_head, count },
+        .positionsY = { m_positionsY.data() + m_head, count },
+        .spawnTimes = { m_spawnTimes.data() + m_head, count },
+        .expirationTimes = { m_expirationTimes.data() + m_head, count },
+        .timesAlive = { m_timesAlive.data() + m_head, count },
+        .lifePercentages = { m_lifePercentages.data() + m_head, count },
+        .energies = { m_energies.data() + m_head, count }
+      };
+    }
+
+    [[nodiscard]]
+    ParticleSpan getSpan() const { return { m_particles.data() + m_head, size() }; }
+
+    // [0, 1) per particle, as of the last update
+    [[nodiscard]]
+    std::span< const float > getLifePercentages() const
+    {
+      return { m_lifePercentages.data() + m_head, size() };
+    }
+
+    [[nodiscard]]
+    size_t size() const { return m_particles.size() - m_head; }
+
+    [[nodiscard]]
+    bool empty() const { return size() == 0; }
+
+    IParticle * operator[]( const size_t index ) const { return m_particles[ m_head + index ]; }
+
+    auto begin() const { return m_particles.begin() + static_cast< std::ptrdiff_t >( m_head ); }
+    auto end() const { return m_particles.end(); }
+
+  private:
+
+    // the particles added since the last update were set up through IParticle
+    void takeOverSpawned()
+    {
+      for ( size_t i = m_spawnedFrom; i < m_particles.size(); ++i )
+      {
+        const auto * particle = m_particles[ i ];
+        const auto position = particle->getPosition();
+
+        m_positionsX[ i ] = position.x;
+        m_positionsY[ i ] = position.y;
+        m_spawnTimes[ i ] = particle->getSpawnTimeInSeconds();
+        m_expirationTimes[ i ] = particle->getExpirationTimeInSeconds();
+        m_timesAlive[ i ] = particle->getTimeAliveInSeconds();
+        m_energies[ i ] = particle->getEnergy();
+      }
+
+      m_spawnedFrom = m_particles.size();
+    }
+
+    // drops the oldest particles
+    void popFront( const size_t count )
+    {
+      for ( size_t i = m_head; i < m_head + count; ++i )
+        delete m_particles[ i ];
+
+      m_head += count;
+
+      if ( m_head == m_particles.size() )
+      {
+        forEachArray( []( auto& array ) { array.clear(); } );
+        m_head = 0;
+      }
+      else if ( m_head >= MIN_COMPACTION_SIZE && m_head * 2 >= m_particles.size() )
+      {
+        // the moves are paid for by the pops since the last compaction
+        const auto head = static_cast< std::ptrdiff_t >( m_head );
+        forEachArray( [ head ]( auto& array ) { array.erase( array.begin(), array.begin() + head ); } );
+        m_head = 0;
+      }
+
+      m_spawnedFrom = m_particles.size();
+    }
+
+    // the general case: one stable pass that also gets rid of the space in front of the head
+    void removeExpired()
+    {
+      size_t aliveCount = 0;
+
+      for ( size_t i = m_head; i < m_particles.size(); ++i )
+      {
+        if ( m_lifePercentages[ i ] >= 1.f )
+        {
+          delete m_particles[ i ];
+          continue;
+        }
+
+        forEachArray( [ i, aliveCount ]( auto& array ) { array[ aliveCount ] = array[ i ]; } );
+        ++aliveCount;
+      }
+
+      forEachArray( [ aliveCount ]( auto& array ) { array.resize( aliveCount ); } );
+      m_head = 0;
+      m_spawnedFrom = aliveCount;
+    }
+
+    // every per-particle array, so that the FIFO moves them together
+    template < typename TFunction >
+    void forEachArray( TFunction&& function )
+    {
+      std::apply( [ &function ]( auto&... arrays ) { ( function( arrays ), ... ); },
+                  std::tie( m_particles,
+                            m_positionsX,
+                            m_positionsY,
+                            m_spawnTimes,
+                            m_expirationTimes,
+                            m_timesAlive,
+                            m_lifePercentages,
+                            m_energies ) );
+    }
+
+    // the chance of a spawn drops from 1 where the thinning starts to 0 at the limit
+    [[nodiscard]]
+    bool shouldThin()
+    {
+      if ( m_limit.policy != E_ParticleLimitPolicy::E_ThinSpawns || m_limit.maxCount == 0 )
+        return false;
+
+      const auto maxCount = static_cast< float >( m_limit.maxCount );
+      const auto thinningStart = maxCount * THINNING_START;
+      const auto count = static_cast< float >( size() );
+
+      if ( count < thinningStart ) return false;
+      if ( count >= maxCount ) return true;
+
+      const auto spawnChance = ( maxCount - count ) / ( maxCount - thinningStart );
+      return m_spawnDistribution( m_rand ) >= spawnChance;
+    }
+
+  private:
+    // everything before the head has been dropped already
+    std::vector< IParticle * > m_particles;
+    std::vector< float > m_positionsX;
+    std::vector< float > m_positionsY;
+    std::vector< float > m_spawnTimes;
+    std::vector< float > m_expirationTimes;
+    std::vector< float > m_timesAlive;
+    std::vector< float > m_lifePercentages;
+    std::vector< float > m_energies;
+    size_t m_head { 0 };
+
+    // where the particles start whose state hasn't been taken over yet
+    size_t m_spawnedFrom { 0 };
+
+    ParticleLimit_t m_limit;
+    size_t m_droppedCount { 0 };
+
+    std::mt19937 m_rand { std::random_device{}() };
+    std::uniform_real_distribution< float > m_spawnDistribution { 0.f, 1.f };
+
+    static constexpr float THINNING_START = 0.75f;
+
+    // below this the head just keeps moving
+    static constexpr size_t MIN_COMPACTION_SIZE = 64;
+  };
+
+}
@@ -51,6 +51,22 @@ namespace nx
       shader.first->trigger( buffer );
   }
 
+  bool ShaderPipeline::isAnimating() const
+  {
+    return std::ranges::any_of( m_shaders, []( const ShaderPair& shader )
+    {
+      return shader.first->isShaderActive() && shader.first->isAnimating();
+    } );
+  }
+
+  bool ShaderPipeline::hasFeedback() const
+  {
+    return std::ranges::any_of( m_shaders, []( const ShaderPair& shader )
+    {
+      return shader.first->isShaderActive() && shader.first->hasFeedback();
+    } );
+  }
+
   void ShaderPipeline::drawMenu()
   {
     drawShadersAvailable();
@@ -65,6 +81,8 @@ namespace nx
 
     for ( auto& shader : m_shaders )
     {
+      if ( m_skipOptionalShaders && shader.first->isOptional() ) continue;
+
       if ( shader.first->isShaderActive() )
       {
         shader.second.startTimer();
@@ -340,4 +358,4 @@ namespace nx
   }
 
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -76,6 +76,19 @@ namespace nx
 
     sf::RenderTexture * draw( const sf::RenderTexture * inTexture );
 
+    // goes along with the texture returned by draw()
+    [[nodiscard]]
+    GpuFence::Sync getOutputFence() const { return m_outputTexture.getFence(); }
+
+    // handed back by the consumer of the output. only call this from the render thread.
+    void setConsumerFence( const GpuFence::Sync fence ) { m_outputTexture.setConsumerFence( fence ); }
+
+    // used by the frame budget. only call this from the render thread.
+    void setSkipOptionalShaders( const bool skipOptionalShaders )
+    {
+      m_skipOptionalShaders = skipOptionalShaders;
+    }
+
     ///////////////////////////////////////////////////////
     /// Shader management
     ///////////////////////////////////////////////////////
@@ -93,6 +106,13 @@ namespace nx
     [[nodiscard]]
     size_t size() const { return m_shaders.size(); }
 
+    // whether any active shader still changes the output on its own
+    [[nodiscard]]
+    bool isAnimating() const;
+
+    [[nodiscard]]
+    bool hasFeedback() const;
+
     [[nodiscard]]
     IShader * getShader( int position ) const;
 
@@ -129,10 +149,13 @@ namespace nx
 
     //std::vector< std::unique_ptr< IShader > > m_shaders;
     std::vector< ShaderPair > m_shaders;
-    LazyTexture m_outputTexture;
+    // this is what the main thread composites
+    LazyTexture m_outputTexture { E_TextureHandoff::E_SharedContext };
 
     RequestSink& m_requestSink;
 
+    bool m_skipOptionalShaders { false };
+
     std::mutex m_mutex;
   };
 
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "models/IParticle.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Uniform grid over the particle positions of a channel, for finding the
+  /// particles near a point without comparing every pair. The modifier pipeline
+  /// rebuilds it once per frame when a modifier asks for neighbors, with cells as
+  /// big as the largest radius asked for, so a query only touches about 3x3 cells.
+  ///
+  /// The positions are copied in, so the grid stays valid after the particles
+  /// move or go away. The indices in the results refer to the span the grid was
+  /// built from (see isBuiltFrom).
+  ///
+  /// The cells are unbounded and hashed into a table of about twice as many
+  /// buckets as there are particles, so a particle flung far off screen doesn't
+  /// stretch the grid. The particles are counting-sorted by bucket, which makes a
+  /// rebuild O(n) and a bucket a contiguous run. Every slot remembers its cell,
+  /// so a bucket shared by several cells only yields the particles of the cell
+  /// being visited.
+  class SpatialGrid final
+  {
+  public:
+
+    struct Neighbor_t
+    {
+      uint32_t index { 0 };
+      float distanceSquared { 0.f };
+    };
+
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+    // the cell size should be the largest radius the grid gets queried with
+    void rebuild( const ParticleSpan particles, const float cellSize )
+    {
+      m_source = particles;
+      m_cellSize = std::max( cellSize, MIN_CELL_SIZE );
+      m_inverseCellSize = 1.f / m_cellSize;
+
+      const auto count = particles.size();
+      const auto bucketCount = std::bit_ceil( std::max( count * 2, MIN_BUCKET_COUNT ) );
+      m_bucketMask = static_cast< uint32_t >( bucketCount - 1 );
+
+      m_positions.resize( count );
+      m_buckets.resize( count );
+      m_bucketStarts.assign( bucketCount + 1, 0 );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+        const auto pos = particles[ i ]->getPosition();
+        const auto bucket = getBucket( getCell( pos.x ), getCell( pos.y ) );
+
+        m_positions[ i ] = pos;
+        m_buckets[ i ] = bucket;
+        ++m_bucketStarts[ bucket + 1 ];
+      }
+
+      for ( size_t i = 1; i <= bucketCount; ++i )
+        m_bucketStarts[ i ] += m_bucketStarts[ i - 1 ];
+
+      // fills every bucket from its start, which keeps the indices ascending
+      m_bucketFill.assign( m_bucketStarts.begin(), m_bucketStarts.end() - 1 );
+      m_slotIndices.resize( count );
+      m_slotPositions.resize( count );
+      m_slotCells.resize( count );
+
+      for ( size_t i = 0; i < count; ++i )
+      {
+        const auto slot = m_bucketFill[ m_buckets[ i ] ]++;
+        const auto& pos = m_positions[ i ];
+        m_slotIndices[ slot ] = static_cast< uint32_t >( i );
+        m_slotPositions[ slot ] = pos;
+        m_slotCells[ slot ] = { getCell( pos.x ), getCell( pos.y ) };
+      }
+    }
+
+    // the grid isn't built from anything until the next rebuild
+    void clear()
+    {
+      m_source = {};
+      m_positions.clear();
+      m_buckets.clear();
+      m_bucketStarts.clear();
+      m_slotIndices.clear();
+      m_slotPositions.clear();
+      m_slotCells.clear();
+    }
+
+    // whether the indices of the results line up with these particles
+    [[nodiscard]]
+    bool isBuiltFrom( const ParticleSpan particles ) const
+    {
+      return particles.data() == m_source.data() && particles.size() == m_source.size();
+    }
+
+    [[nodiscard]]
+    size_t size() const { return m_positions.size(); }
+
+    [[nodiscard]]
+    bool empty() const { return m_positions.empty(); }
+
+    // the position as of the last rebuild
+    [[nodiscard]]
+    const sf::Vector2f& getPosition( const uint32_t index ) const { return m_positions[ index ]; }
+
+    // calls fn( index, distanceSquared ) for every particle within the radius
+    template < typename F >
+    void forEachInRadius( const sf::Vector2f& center, const float radius, F&& fn ) const
+    {
+      const float radiusSquared = radius * radius;
+
+      forEachCandidate( center, radius, [ & ]( const uint32_t slot )
+      {
+        const auto delta = m_slotPositions[ slot ] - center;
+        const float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+
+        if ( distanceSquared <= radiusSquared )
+          fn( m_slotIndices[ slot ], distanceSquared );
+      } );
+    }
+
+    // the particles within the radius, in no particular order
+    void findInRadius( const sf::Vector2f& center,
+                       const float radius,
+                       std::vector< Neighbor_t >& outNeighbors,
+                       const uint32_t excludeIndex = NO_INDEX ) const
+    {
+      outNeighbors.clear();
+      forEachInRadius( center, radius, [ & ]( const uint32_t index, const float distanceSquared )
+      {
+        if ( index != excludeIndex )
+          outNeighbors.push_back( { index, distanceSquared } );
+      } );
+    }
+
+    // up to k of the nearest particles within the max distance, nearest first.
+    // ties go to the lower index.
+    void findNearest( const sf::Vector2f& center,
+                      const size_t k,
+                      const float maxDistance,
+                      std::vector< Neighbor_t >& outNeighbors,
+                      const uint32_t excludeIndex = NO_INDEX ) const
+    {
+      outNeighbors.clear();
+      if ( k == 0 ) return;
+
+      const auto isCloser = []( const Neighbor_t& a, const Neighbor_t& b )
+      {
+        return a.distanceSquared < b.distanceSquared ||
+               ( a.distanceSquared == b.distanceSquared && a.index < b.index );
+      };
+
+      // k is small, so keeping the best ones sorted as they come in beats sorting them all.
+      // once there are k of them, anything farther than the last one can be skipped.
+      float cutoffSquared = maxDistance * maxDistance;
+
+      forEachCandidate( center, maxDistance, [ & ]( const uint32_t slot )
+      {
+        const auto delta = m_slotPositions[ slot ] - center;
+        const float distanceSquared = delta.x * delta.x + delta.y * delta.y;
+        if ( distanceSquared > cutoffSquared ) return;
+
+        const Neighbor_t neighbor { m_slotIndices[ slot ], distanceSquared };
+        if ( neighbor.index == excludeIndex ) return;
+
+        if ( outNeighbors.size() == k )
+        {
+          if ( !isCloser( neighbor, outNeighbors.back() ) ) return;
+          outNeighbors.pop_back();
+        }
+
+        outNeighbors.insert( std::ranges::upper_bound( outNeighbors, neighbor, isCloser ), neighbor );
+
+        if ( outNeighbors.size() == k )
+          cutoffSquared = outNeighbors.back().distanceSquared;
+      } );
+    }
+
+  private:
+
+    struct Cell_t
+    {
+      int32_t column { 0 };
+      int32_t row { 0 };
+
+      bool operator==( const Cell_t& ) const = default;
+    };
+
+    // calls fn( slot ) for every particle in a cell that overlaps the square around the center
+    template < typename F >
+    void forEachCandidate( const sf::Vector2f& center, const float radius, F&& fn ) const
+    {
+      if ( empty() ) return;
+
+      const auto firstColumn = getCell( center.x - radius );
+      const auto lastColumn = getCell( center.x + radius );
+      const auto firstRow = getCell( center.y - radius );
+      const auto lastRow = getCell( center.y + radius );
+
+      const auto cellCount = ( static_cast< int64_t >( lastColumn ) - firstColumn + 1 ) *
+                             ( static_cast< int64_t >( lastRow ) - firstRow + 1 );
+
+      // only when the query covers more cells than there are buckets, e.g., a radius much
+      // bigger than the cells. every bucket would get visited, so it's cheaper to check them all.
+      if ( cellCount > static_cast< int64_t >( m_bucketMask ) )
+      {
+        for ( uint32_t slot = 0; slot < size(); ++slot )
+          fn( slot );
+
+        return;
+      }
+
+      for ( auto row = firstRow; row <= lastRow; ++row )
+      {
+        for ( auto column = firstColumn; column <= lastColumn; ++column )
+        {
+          const auto bucket = getBucket( column, row );
+          const Cell_t cell { column, row };
+
+          // cells that hash alike share the bucket, so every particle is only visited with its own cell
+          for ( auto slot = m_bucketStarts[ bucket ]; slot < m_bucketStarts[ bucket + 1 ]; ++slot )
+          {
+            if ( m_slotCells[ slot ] == cell )
+              fn( slot );
+          }
+        }
+      }
+    }
+
+    // written so that NaN ends up in cell 0 and nothing overflows
+    [[nodiscard]]
+    int32_t getCell( const float coordinate ) const
+    {
+      const auto cell = std::floor( coordinate * m_inverseCellSize );
+      if ( !( cell > -MAX_CELL ) ) return cell < 0.f ? static_cast< int32_t >( -MAX_CELL ) : 0;
+      return static_cast< int32_t >( std::min( cell, MAX_CELL ) );
+    }
+
+    [[nodiscard]]
+    uint32_t getBucket( const int32_t column, const int32_t row ) const
+    {
+      const auto hash = static_cast< uint32_t >( column ) * 73856093u ^
+                        static_cast< uint32_t >( row ) * 19349663u;
+      return hash & m_bucketMask;
+    }
+
+  private:
+
+    ParticleSpan m_source;
+
+    // by particle index
+    std::vector< sf::Vector2f > m_positions;
+    std::vector< uint32_t > m_buckets;
+
+    // the slots of bucket b are [ m_bucketStarts[ b ], m_bucketStarts[ b + 1 ] )
+    std::vector< uint32_t > m_bucketStarts;
+    std::vector< uint32_t > m_bucketFill;
+    uint32_t m_bucketMask { 0 };
+
+    // by slot, so a query reads the positions front to back
+    std::vector< uint32_t > m_slotIndices;
+    std::vector< sf::Vector2f > m_slotPositions;
+    std::vector< Cell_t > m_slotCells;
+
+    float m_cellSize { MIN_CELL_SIZE };
+    float m_inverseCellSize { 1.f / MIN_CELL_SIZE };
+
+    static constexpr float MIN_CELL_SIZE = 1.f;
+    static constexpr float MAX_CELL = 1 << 30;
+    static constexpr size_t MIN_BUCKET_COUNT = 64;
+  };
+
+}
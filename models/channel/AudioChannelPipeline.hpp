@@ -17,8 +17,6 @@
 
 #include <imgui.h>
 
-#include "vst/analysis/FFTBuffer.hpp"
-
 #include "models/channel/ChannelPipeline.hpp"
 #include "models/data/PipelineContext.hpp"
 #include "models/audio/FFTProcessor.hpp"
@@ -34,17 +32,20 @@ namespace nx
 
     ~AudioChannelPipeline() override = default;
 
-    void processAudioBuffer( FFTBuffer& buffer )
+    void processAudioBuffer( const AudioDataBuffer& audioBuffer )
     {
-      // receive the unscaled audio buffer
-      const auto& audioBuffer = buffer.getBuffer();
-
       // scale the FFT buffer to user-customizable values
-      m_scaler.apply( m_ctx.globalInfo.sampleRate, audioBuffer );
+      m_scaler.apply( m_frameInfo.sampleRate, audioBuffer );
       m_particleLayout.processAudioBuffer( m_scaler );
       m_shaderPipeline.processAudioBuffer( audioBuffer );
     }
 
+    void processInput( const ChannelInput_t& input ) override
+    {
+      for ( const auto& frame : input.audioFrames )
+        processAudioBuffer( frame );
+    }
+
     void update( const sf::Time& deltaTime ) const override
     {
       m_particleLayout.update( deltaTime );
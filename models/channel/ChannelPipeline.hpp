@@ -17,7 +17,10 @@
 
 #include "utils/TaskQueue.hpp"
 
+#include "models/data/Midi_t.hpp"
+#include "models/FrameBudgetScheduler.hpp"
 #include "models/ParticleLayoutManager.hpp"
+#include "models/ParticlePool.hpp"
 #include "models/ModifierPipeline.hpp"
 #include "models/ShaderPipeline.hpp"
 
@@ -28,10 +31,12 @@ namespace nx
   public:
     ChannelPipeline( PipelineContext& ctx, const int32_t channelId )
       : m_ctx( ctx ),
+        m_frameInfo( ctx.globalInfo ),
+        m_frameCtx( m_frameInfo, ctx.vstContext ),
         m_drawPriority( channelId ),
-        m_particleLayout( ctx ),
-        m_modifierPipeline( ctx ),
-        m_shaderPipeline( ctx, *this )
+        m_particleLayout( m_frameCtx ),
+        m_modifierPipeline( m_frameCtx ),
+        m_shaderPipeline( m_frameCtx, *this )
     {
       // check the 0th value to see whether the static values haven't been written yet
       if ( m_drawPriorityNames[ 0 ].empty() )
@@ -49,6 +54,7 @@ namespace nx
       j[ "channel" ][ "particles" ] = m_particleLayout.serialize();
       j[ "channel" ][ "modifiers" ] = m_modifierPipeline.saveModifierPipeline();
       j[ "channel" ][ "shaders" ] = m_shaderPipeline.saveShaderPipeline();
+      j[ "channel" ][ "budgetPriority" ] = m_budgetPriority;
       return j;
     }
 
@@ -57,6 +63,8 @@ namespace nx
       if ( j.contains( "channel" ) )
       {
         const auto& jchannel = j[ "channel" ];
+        m_budgetPriority = jchannel.value( "budgetPriority", DEFAULT_BUDGET_PRIORITY );
+
         if ( jchannel.contains( "particles" ) )
           m_particleLayout.deserialize( jchannel.at( "particles" ) );
         else
@@ -87,22 +95,98 @@ namespace nx
       }
     }
 
+    // the main thread only queues up input. everything gets processed
+    // on the render thread as part of the next job.
+    void queueUpdate( const sf::Time& deltaTime )
+    {
+      m_pendingInput.deltaTime += deltaTime;
+    }
+
+    void queueMidiEvent( const Midi_t& midiEvent )
+    {
+      m_pendingInput.midiEvents.push_back( midiEvent );
+    }
+
+    void queueAudioData( const AudioDataBuffer& buffer )
+    {
+      // a channel that can't keep up only gets the newest frames
+      auto& frames = m_pendingInput.audioFrames;
+      if ( frames.size() == MAX_PENDING_AUDIO_FRAMES )
+        frames.erase( frames.begin() );
+
+      frames.push_back( buffer );
+    }
+
     void requestRenderUpdate() override
     {
-      // this comes in on the main thread,
-      // but we need to move it to the render thread
-      request( [ this ]
+      // this comes in on the main thread while the render thread is idle
+      takePendingInput();
+
+      // we need to move the simulation and rendering to the render thread
+      request( [ this,
+                 degradeLevel = m_degradeLevel,
+                 particleLimit = m_particleLimit,
+                 consumerFence = std::exchange( m_consumerFence, nullptr ) ]
       {
+        ParticlePool::Scope poolScope( &m_particlePool );
+
+        m_shaderPipeline.setConsumerFence( consumerFence );
+        applyDegradeLevel( degradeLevel );
+        simulate( particleLimit );
+
+        // the simulation is done for this frame, so the live particles can be drawn as they are
         const auto * modifierTexture = m_modifierPipeline.applyModifiers(
           m_particleLayout.getParticles(),
           m_blendMode );
 
         m_outputTexture = m_shaderPipeline.draw( modifierTexture );
+        m_outputFence = m_shaderPipeline.getOutputFence();
+        updateSettledState();
+      } );
+    }
+
+    // used while muted, so the channel keeps moving without being drawn
+    void requestSimulationUpdate()
+    {
+      takePendingInput();
+      request( [ this, particleLimit = m_particleLimit ]
+      {
+        ParticlePool::Scope poolScope( &m_particlePool );
+        simulate( particleLimit );
+        updateSettledState();
       } );
     }
 
+    // true when a new job would draw the same thing as the last one did.
+    // only call this from the main thread while no job is in flight.
+    [[nodiscard]]
+    bool isIdle() const
+    {
+      if ( !m_isSettled || m_isDirty || m_outputTexture == nullptr ) return false;
+      if ( !m_pendingInput.midiEvents.empty() || hasPendingTasks() ) return false;
+      if ( m_outputTexture->getSize() != m_ctx.globalInfo.windowSize ) return false;
+
+      return std::ranges::all_of( m_pendingInput.audioFrames, []( const AudioDataBuffer& frame )
+      {
+        return std::ranges::all_of( frame, []( const float bin ) { return bin <= 0.f; } );
+      } );
+    }
+
+    // called instead of a job when the channel is idle. there's nothing
+    // to catch up on, so the time and the (silent) audio get dropped.
+    void skipFrame()
+    {
+      m_pendingInput.deltaTime = sf::Time::Zero;
+      m_pendingInput.audioFrames.clear();
+    }
+
+    // forces the next job to run, e.g., after changing settings
+    void markDirty() { m_isDirty = true; }
+
     void requestShutdown() override
     {
+      GpuFence::destroy( std::exchange( m_consumerFence, nullptr ) );
+
       request( [ this ]
       {
         // this asks all other pipelines to shut down
@@ -111,6 +195,31 @@ namespace nx
       } );
     }
 
+    // the draw priority menu only offers the channels that are in use
+    void setActiveChannels( const std::vector< int32_t > * activeChannels ) { m_activeChannels = activeChannels; }
+
+    // lets the channel split its work into tasks on the render pool
+    void setTaskPool( WorkStealingPool * taskPool )
+    {
+      m_modifierPipeline.setTaskPool( taskPool );
+    }
+
+    // picked up by the next render job
+    void setDegradeLevel( const E_DegradeLevel degradeLevel ) { m_degradeLevel = degradeLevel; }
+
+    // picked up by the next job
+    void setParticleLimit( const ParticleLimit_t& particleLimit ) { m_particleLimit = particleLimit; }
+
+    // the particles evicted or thinned out by the limit so far
+    [[nodiscard]]
+    uint64_t getDroppedParticleCount() const { return m_droppedParticleCount.load( std::memory_order_relaxed ); }
+
+    [[nodiscard]]
+    const ParticlePool& getParticlePool() const { return m_particlePool; }
+
+    // the frame budget degrades higher priority channels last
+    int32_t getBudgetPriority() const { return m_budgetPriority; }
+
     void toggleBypass() { m_isBypassed = !m_isBypassed; }
     bool isBypassed() const { return m_isBypassed; }
 
@@ -120,17 +229,44 @@ namespace nx
     virtual void drawMenu() = 0;
 
     sf::RenderTexture * getOutputTexture() const { return m_outputTexture; }
+
+    // wait on this before sampling the output texture from another thread
+    GpuFence::Sync getOutputFence() const { return m_outputFence; }
+
+    // called on the main thread right after the output was drawn. the next render
+    // job waits on it before it draws into the output textures again.
+    void setConsumerFence( const GpuFence::Sync fence )
+    {
+      // it never made it to a job, so nothing else knows about it
+      GpuFence::destroy( m_consumerFence );
+      m_consumerFence = fence;
+    }
     int32_t getDrawPriority() const { return m_drawPriority; }
     const sf::BlendMode& getChannelBlendMode() const { return m_blendMode; }
 
   protected:
 
+    // everything the main thread hands over for a single job
+    struct ChannelInput_t
+    {
+      sf::Time deltaTime;
+      std::vector< Midi_t > midiEvents;
+
+      // every FFT frame that arrived since the last job, oldest first
+      std::vector< AudioDataBuffer > audioFrames;
+    };
+
+    // consumes the events and audio data for the job. runs on the render thread.
+    virtual void processInput( const ChannelInput_t& input ) = 0;
+
     virtual void drawChannelPriorityMenu()
     {
+      if ( m_activeChannels == nullptr ) return;
+
       if ( ImGui::BeginCombo( "Draw Priority",
                         m_drawPriorityNames[ m_drawPriority ].c_str() ) )
       {
-        for ( int32_t i = 0; i < MAX_MIDI_CHANNELS; ++i )
+        for ( const auto i : *m_activeChannels )
         {
           if ( ImGui::Selectable( m_drawPriorityNames[ i ].c_str(),
                                   i == m_drawPriority ) )
@@ -148,6 +284,7 @@ namespace nx
       if ( ImGui::TreeNode( "Channel Options" ) )
       {
         ImGui::Checkbox( "Mute", &m_isBypassed );
+        ImGui::SliderInt( "Budget Priority", &m_budgetPriority, 0, MAX_BUDGET_PRIORITY );
 
         ImGui::SeparatorText( "Channel Blend" );
         MenuHelper::drawBlendOptions( m_blendMode );
@@ -160,20 +297,111 @@ namespace nx
   protected:
 
     PipelineContext& m_ctx;
+
+    // the global info as it was when the job was launched. the main thread keeps
+    // writing the live one, so everything that runs in the job reads this copy.
+    GlobalInfo_t m_frameInfo;
+    PipelineContext m_frameCtx;
+
     int32_t m_drawPriority;
 
+    // has to outlive everything that holds particles
+    ParticlePool m_particlePool;
+
     ParticleLayoutManager m_particleLayout;
     ModifierPipeline m_modifierPipeline;
     ShaderPipeline m_shaderPipeline;
 
     bool m_isBypassed { false };
 
+    E_DegradeLevel m_degradeLevel { E_DegradeLevel::E_None };
+    ParticleLimit_t m_particleLimit;
+    std::atomic< uint64_t > m_droppedParticleCount { 0 };
+    int32_t m_budgetPriority { DEFAULT_BUDGET_PRIORITY };
+
     // this is the final texture handed back to the client
     sf::RenderTexture * m_outputTexture { nullptr };
+    GpuFence::Sync m_outputFence { nullptr };
+
+    // written by the main thread, handed to the next render job
+    GpuFence::Sync m_consumerFence { nullptr };
 
     sf::BlendMode m_blendMode;
 
   private:
+
+    void applyDegradeLevel( const E_DegradeLevel degradeLevel )
+    {
+      m_modifierPipeline.setDetailScale(
+        degradeLevel >= E_DegradeLevel::E_ReducedSegments ? REDUCED_DETAIL_SCALE : 1.f );
+
+      m_shaderPipeline.setSkipOptionalShaders(
+        degradeLevel >= E_DegradeLevel::E_SkipOptionalShaders );
+    }
+
+    // runs on the render thread at the end of every job
+    void updateSettledState()
+    {
+      const auto particles = m_particleLayout.getParticles();
+      const bool isSameCount = particles.size() == m_lastParticleCount;
+      m_lastParticleCount = particles.size();
+
+      m_isSettled = isSameCount &&
+                    !m_shaderPipeline.isAnimating() &&
+                    !m_shaderPipeline.hasFeedback() &&
+                    std::ranges::none_of( particles, []( const IParticle * particle )
+                    {
+                      return !particle->hasExpired();
+                    } );
+    }
+
+    void takePendingInput()
+    {
+      m_isDirty = false;
+      m_frameInfo = m_ctx.globalInfo;
+
+      // swapping keeps the event buffers allocated between frames
+      std::swap( m_pendingInput, m_jobInput );
+      m_pendingInput.deltaTime = sf::Time::Zero;
+      m_pendingInput.midiEvents.clear();
+      m_pendingInput.audioFrames.clear();
+    }
+
+    void simulate( const ParticleLimit_t& particleLimit )
+    {
+      m_particleLayout.setParticleLimit( particleLimit );
+
+      processInput( m_jobInput );
+      update( m_jobInput.deltaTime );
+
+      m_droppedParticleCount.fetch_add( m_particleLayout.takeDroppedParticleCount(),
+                                        std::memory_order_relaxed );
+    }
+
+  private:
+
+    // owned by the multichannel pipeline
+    const std::vector< int32_t > * m_activeChannels { nullptr };
+
+    // written by the main thread between jobs
+    ChannelInput_t m_pendingInput;
+
+    // read by the render thread during a job
+    ChannelInput_t m_jobInput;
+
+    // written by the render thread, only read between jobs
+    bool m_isSettled { false };
+    size_t m_lastParticleCount { 0 };
+
+    bool m_isDirty { true };
+
+    static constexpr int32_t DEFAULT_BUDGET_PRIORITY = 5;
+    static constexpr int32_t MAX_BUDGET_PRIORITY = 9;
+    static constexpr float REDUCED_DETAIL_SCALE = 0.5f;
+
+    // about a tenth of a second of FFT frames
+    static constexpr size_t MAX_PENDING_AUDIO_FRAMES = 8;
+
     inline static std::array< std::string, MAX_CHANNELS > m_drawPriorityNames;
   };
 }
\ No newline at end of file
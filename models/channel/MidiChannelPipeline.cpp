@@ -33,6 +33,12 @@ namespace nx
     m_shaderPipeline.processMidiEvent( midiEvent );
   }
 
+  void MidiChannelPipeline::processInput( const ChannelInput_t& input )
+  {
+    for ( const auto& midiEvent : input.midiEvents )
+      processMidiEvent( midiEvent );
+  }
+
   void MidiChannelPipeline::update( const sf::Time& deltaTime ) const
   {
     m_particleLayout.update( deltaTime );
@@ -37,5 +37,9 @@ namespace nx
 
     void drawMenu() override;
 
+  protected:
+
+    void processInput( const ChannelInput_t& input ) override;
+
   };
 }
\ No newline at end of file
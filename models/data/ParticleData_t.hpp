@@ -32,6 +32,7 @@ X( fillStartColor,  sf::Color, sf::Color(255, 255, 255),    0, 255, "Particle fi
 X( fillEndColor,    sf::Color, sf::Color(255, 255, 255),      0, 255, "Particle fill color B", false)      \
 X( outlineStartColor,  sf::Color, sf::Color(255, 255, 255),    0, 255, "Particle fill color A", false)   \
 X( outlineEndColor,    sf::Color, sf::Color(255, 255, 255),      0, 255, "Particle fill color B", false)   \
+X( fadeInShader,    bool, false, 0, 1, "Fade the particles while drawing instead of recoloring them every frame", false ) \
 
   // holds info ONLY related to the particle
   struct ParticleData_t
@@ -50,4 +51,4 @@ X( outlineEndColor,    sf::Color, sf::Color(255, 255, 255),      0, 255, "Partic
     EXPAND_SHADER_PARAM_LABELS(PARTICLE_DATA_PARAMS)
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
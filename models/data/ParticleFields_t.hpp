@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <span>
+
+#include "models/IParticle.hpp"
+
+namespace nx
+{
+  ///
+  /// The per-particle arrays of a layout's particle store, all in spawn order and of
+  /// the same length. The behaviors move the particles through the positions, which
+  /// the store writes back to the particles once the layout is done updating.
+  struct ParticleFields_t
+  {
+    ParticleSpan particles;
+
+    std::span< float > positionsX;
+    std::span< float > positionsY;
+
+    std::span< const float > spawnTimes;
+    std::span< const float > expirationTimes;
+    std::span< const float > timesAlive;
+
+    // [0, 1) as of the last update
+    std::span< const float > lifePercentages;
+
+    // the midi velocity or FFT magnitude the particle was spawned with
+    std::span< const float > energies;
+
+    [[nodiscard]]
+    size_t size() const { return particles.size(); }
+
+    [[nodiscard]]
+    bool empty() const { return particles.empty(); }
+  };
+}
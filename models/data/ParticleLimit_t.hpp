@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+namespace nx
+{
+  enum class E_ParticleLimitPolicy : int8_t
+  {
+    // the oldest particles make room for the new ones
+    E_EvictOldest,
+
+    // new particles get rarer as the count closes in on the limit
+    E_ThinSpawns
+  };
+
+  // how many particles a layout may keep. 0 means there's no limit.
+  struct ParticleLimit_t
+  {
+    size_t maxCount { 0 };
+    E_ParticleLimitPolicy policy { E_ParticleLimitPolicy::E_EvictOldest };
+  };
+}
@@ -70,6 +70,13 @@ namespace nx
       return std::clamp( total, 0.f, 1.5f );
     }
 
+    [[nodiscard]]
+    bool isAnimating() const
+    {
+      return std::ranges::any_of( m_bursts,
+        []( const TimeEasing& burst ) { return burst.isAnimating(); } );
+    }
+
     float getLastTriggeredInSeconds() const { return m_lastTriggerInSeconds; }
 
   private:
@@ -83,4 +90,4 @@ namespace nx
     TimeEasing m_masterEasing;
     std::vector< TimeEasing > m_bursts;
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
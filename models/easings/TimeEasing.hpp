@@ -71,11 +71,43 @@ namespace nx
       }
     }
 
+    // whether getEasing() still changes over time
+    [[nodiscard]]
+    bool isAnimating() const
+    {
+      // the easing is stuck at its starting value
+      if ( m_data.decayRate <= 0.001f ) return false;
+
+      const float decay = m_clock.getElapsedTime().asSeconds() / m_data.decayRate;
+
+      switch ( m_data.easingType )
+      {
+        case E_EasingType::E_Disabled:
+        case E_EasingType::E_Fixed:
+          return false;
+
+        case E_EasingType::E_TimeContinuous:
+        case E_EasingType::E_TimeIntervallic:
+        case E_EasingType::E_SparkleFlicker:
+          return true;
+
+        // it never quite gets there, but it's close enough
+        case E_EasingType::E_Impulse:
+          return decay * m_data.intensity < IMPULSE_SETTLED;
+
+        // these are clamped once the decay is done
+        default:
+          return decay < 1.f;
+      }
+    }
+
   private:
 
+    static constexpr float IMPULSE_SETTLED = 10.f;
+
     float m_timeTriggeredInSeconds { 0.f };
     sf::Clock m_clock;
 
 
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
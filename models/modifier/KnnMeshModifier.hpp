@@ -18,6 +18,8 @@
 #include "helpers/LineHelper.hpp"
 #include "helpers/SerialHelper.hpp"
 
+#include "models/SpatialGrid.hpp"
+
 namespace nx
 {
 
@@ -107,75 +109,70 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     void processMidiEvent(const Midi_t&) override {}
 
+    void setDetailScale( const float detailScale ) override { m_detailScale = detailScale; }
+
+    float getNeighborRadius() const override { return m_data.maxDistance.first; }
+
+    void setSpatialGrid( const SpatialGrid * spatialGrid ) override { m_spatialGrid = spatialGrid; }
+
     void modify(const sf::BlendMode& blendMode,
-                std::deque<IParticle*>& particles,
-                std::deque<sf::Drawable*>& outArtifacts) override
+                ParticleSpan particles,
+                std::vector<sf::Drawable*>& outArtifacts) override
     {
       if (particles.size() < 3)
         return;
 
+      const auto& grid = getSpatialGrid( particles );
       const size_t count = particles.size();
+      const auto segments = scaleSegments( m_data.lineSegments.first, m_detailScale );
+
+      auto * lines = new CurvedLineBatch();
+      lines->reserve( count * static_cast< size_t >( m_data.kNeighbors.first ), segments );
 
       for (size_t i = 0; i < count; ++i)
       {
         const auto* a = particles[i];
         const auto& posA = a->getPosition();
 
-        std::vector< std::pair< float, size_t > > distances;
-        for (size_t j = 0; j < count; ++j)
-        {
-          if (i == j) continue;
-
-          const auto* b = particles[j];
-          const float dist = MathHelper::getDistance(posA, b->getPosition());
-          if (dist <= m_data.maxDistance.first)
-            distances.emplace_back(dist, j);
-        }
-
-        std::ranges::sort(distances);
+        grid.findNearest( posA,
+                          static_cast< size_t >( m_data.kNeighbors.first ),
+                          m_data.maxDistance.first,
+                          m_neighbors,
+                          static_cast< uint32_t >( i ) );
 
-        const size_t limit = std::min<size_t>(m_data.kNeighbors.first, distances.size());
-        for (size_t k = 0; k < limit; ++k)
+        for ( const auto& neighbor : m_neighbors )
         {
-          const auto& [dist, j] = distances[k];
-          const auto* b = particles[j];
-
-          auto * line = new CurvedLine(
-            posA,
-            b->getPosition(),
-            m_data.curvature.first,
-            m_data.lineSegments.first );
-
-          outArtifacts.emplace_back( line );
-
-          line->setWidth( m_data.lineThickness.first );
-
-          if ( m_data.useParticleColors.first )
-          {
-            LineHelper::updateLineColors( line,
-              a,
-              b,
-              m_data.invertColorTime.first );
-          }
-          else
-          {
-            LineHelper::updateCustomLineColors(
-              line,
-              b,
-              a,
-              m_data.lineColor.first,
-              m_data.otherLineColor.first,
-              m_data.invertColorTime.first );
-          }
+          const auto* b = particles[neighbor.index];
+
+          const auto colors = m_data.useParticleColors.first
+            ? LineHelper::getLineColors(
+                a,
+                b,
+                m_data.invertColorTime.first )
+            : LineHelper::getCustomLineColors(
+                b,
+                a,
+                m_data.lineColor.first,
+                m_data.otherLineColor.first,
+                m_data.invertColorTime.first );
+
+          lines->append( posA,
+                         b->getPosition(),
+                         m_data.curvature.first,
+                         segments,
+                         m_data.lineThickness.first,
+                         colors );
         }
       }
+
+      emitLines( lines, outArtifacts );
     }
 
     // this uses a few directional bias options that are experimental
     // void modify(
     //   const ParticleLayoutData_t& layoutData,
-    //   std::deque<IParticle*>& particles,
-    //   std::deque<sf::Drawable*>& outArtifacts) override
+    //   ParticleSpan particles,
+    //   std::vector<sf::Drawable*>& outArtifacts) override
     // {
     //   if (!isActive() || particles.empty()) return;
     //
@@ -246,6 +243,17 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
     // }
 
   private:
+
+    // the pipeline's grid, unless it was built from other particles
+    const SpatialGrid& getSpatialGrid( const ParticleSpan particles )
+    {
+      if ( m_spatialGrid != nullptr && m_spatialGrid->isBuiltFrom( particles ) )
+        return *m_spatialGrid;
+
+      m_localGrid.rebuild( particles, m_data.maxDistance.first );
+      return m_localGrid;
+    }
+
     static sf::Vector2f normalize(const sf::Vector2f& v)
     {
       const float len = std::sqrt(v.x * v.x + v.y * v.y);
@@ -266,6 +274,13 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     PipelineContext& m_ctx;
     KnnMeshData_t m_data;
+    float m_detailScale { 1.f };
+
+    const SpatialGrid * m_spatialGrid { nullptr };
+    SpatialGrid m_localGrid;
+
+    // reused for every particle
+    std::vector< SpatialGrid::Neighbor_t > m_neighbors;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -61,8 +61,8 @@ namespace nx
   /////////////////////////////////////////////////////////
   /// PUBLIC
   void MirrorModifier::modify(const sf::BlendMode& blendMode,
-              std::deque< IParticle * > &particles,
-              std::deque< sf::Drawable * > &outArtifacts)
+              ParticleSpan particles,
+              std::vector< sf::Drawable * > &outArtifacts)
   {
     for (const auto* p : particles)
     {
@@ -83,8 +83,8 @@ X(mirrorOutlineColor, sf::Color, sf::Color::White, 0, 255, "Outline color for mi
     }
 
     void modify(const sf::BlendMode& blendMode,
-                std::deque< IParticle * > &particles,
-                std::deque< sf::Drawable * > &outArtifacts) override;
+                ParticleSpan particles,
+                std::vector< sf::Drawable * > &outArtifacts) override;
 
   private:
 
@@ -28,7 +28,7 @@ namespace nx
   {
     nlohmann::json j;
     j[ "type" ] = SerialHelper::serializeEnum( getType() );
-    EXPAND_SHADER_PARAMS_TO_JSON(PARTICLE_LINE_MODIFIER_PARAMS)
+    EXPAND_SHADER_PARAMS_TO_JSON(FULL_MESH_LINE_MODIFIER_PARAMS)
     return j;
   }
 
@@ -38,7 +38,7 @@ namespace nx
   {
     if ( SerialHelper::isTypeGood( j, getType() ) )
     {
-      EXPAND_SHADER_PARAMS_FROM_JSON(PARTICLE_LINE_MODIFIER_PARAMS)
+      EXPAND_SHADER_PARAMS_FROM_JSON(FULL_MESH_LINE_MODIFIER_PARAMS)
     }
     else
     {
@@ -52,7 +52,7 @@ namespace nx
   {
     if ( ImGui::TreeNode( "Full Mesh Lines" ) )
     {
-      EXPAND_SHADER_IMGUI(PARTICLE_LINE_MODIFIER_PARAMS, m_data)
+      EXPAND_SHADER_IMGUI(FULL_MESH_LINE_MODIFIER_PARAMS, m_data)
 
       ImGui::TreePop();
       ImGui::Spacing();
@@ -63,41 +63,138 @@ namespace nx
   /// PUBLIC
   void ParticleFullMeshLineModifier::modify(
      const sf::BlendMode& blendMode,
-     std::deque< IParticle* >& particles,
-     std::deque< sf::Drawable* >& outArtifacts )
+     ParticleSpan particles,
+     std::vector< sf::Drawable* >& outArtifacts )
   {
-    for ( int i = 0; i < particles.size(); ++i )
+    if ( particles.size() < 2 ) return;
+
+    collectLinks( particles );
+
+    // the budget scrambles the order, so put it back the way the pairs are visited
+    std::ranges::sort( m_links, []( const Link_t& a, const Link_t& b )
     {
-      for ( int y = i + 1; y < particles.size(); ++y )
-      {
-        auto * line = new CurvedLine(
-          particles[ i ]->getPosition(),
-          particles[ y ]->getPosition(),
-          m_data.curvature.first,
-          m_data.lineSegments.first );
+      return a.first < b.first || ( a.first == b.first && a.second < b.second );
+    } );
 
-        line->setWidth( m_data.lineThickness.first );
+    const auto segments = scaleSegments( m_data.lineSegments.first, m_detailScale );
 
-        if ( m_data.useParticleColors.first )
-        {
-          LineHelper::updateLineColors( line,
-            particles[ i ],
-            particles[ y ],
-            m_data.invertColorTime.first );
-        }
-        else
-        {
-          LineHelper::updateCustomLineColors(
-            line,
-            particles[ i ],
-            particles[ y ],
+    auto * lines = new CurvedLineBatch();
+    lines->reserve( m_links.size(), segments );
+
+    for ( const auto& link : m_links )
+    {
+      const auto * first = particles[ link.first ];
+      const auto * second = particles[ link.second ];
+
+      const auto colors = m_data.useParticleColors.first
+        ? LineHelper::getLineColors(
+            first,
+            second,
+            m_data.invertColorTime.first )
+        : LineHelper::getCustomLineColors(
+            first,
+            second,
             m_data.lineColor.first,
             m_data.otherLineColor.first,
             m_data.invertColorTime.first );
-        }
 
-        outArtifacts.push_back( line );
+      lines->append( first->getPosition(),
+                     second->getPosition(),
+                     m_data.curvature.first,
+                     segments,
+                     m_data.lineThickness.first,
+                     colors );
+    }
+
+    emitLines( lines, outArtifacts );
+  }
+
+  /////////////////////////////////////////////////////////
+  /// PRIVATE
+  /////////////////////////////////////////////////////////
+  void ParticleFullMeshLineModifier::collectLinks( const ParticleSpan particles )
+  {
+    m_links.clear();
+
+    const auto count = static_cast< uint32_t >( particles.size() );
+    const auto stride = static_cast< uint32_t >( std::max( 1, m_data.connectionStride.first ) );
+    const auto maxLines = static_cast< size_t >( std::max( 1, m_data.maxLines.first ) );
+    const bool preferYoungest = m_data.preferYoungest.first;
+
+    if ( preferYoungest )
+    {
+      m_ages.resize( count );
+      for ( uint32_t i = 0; i < count; ++i )
+        m_ages[ i ] = particles[ i ]->getTimeAliveInSeconds();
+    }
+
+    const auto getRank = [ & ]( const uint32_t first, const uint32_t second, const float distanceSquared )
+    {
+      return preferYoungest ? std::max( m_ages[ first ], m_ages[ second ] ) : distanceSquared;
+    };
+
+    if ( !m_data.linkEveryPair.first )
+    {
+      const float maxDistance = m_data.maxDistance.first;
+      const auto& grid = getSpatialGrid( particles );
+
+      for ( uint32_t i = 0; i < count; ++i )
+      {
+        grid.forEachInRadius( particles[ i ]->getPosition(), maxDistance,
+          [ & ]( const uint32_t j, const float distanceSquared )
+          {
+            // every pair shows up twice, so only the one from the lower index counts
+            if ( j > i && ( j - i ) % stride == 0 )
+              addLink( { i, j, getRank( i, j, distanceSquared ) }, maxLines );
+          } );
       }
     }
+    else
+    {
+      for ( uint32_t i = 0; i < count; ++i )
+      {
+        const auto posA = particles[ i ]->getPosition();
+        for ( uint32_t j = i + stride; j < count; j += stride )
+        {
+          const auto delta = particles[ j ]->getPosition() - posA;
+          addLink( { i, j, getRank( i, j, delta.x * delta.x + delta.y * delta.y ) }, maxLines );
+        }
+      }
+    }
+  }
+
+  /////////////////////////////////////////////////////////
+  /// PRIVATE
+  void ParticleFullMeshLineModifier::addLink( const Link_t& link, const size_t maxLines )
+  {
+    // ties go to the pairs visited first, so the same particles pick the same links
+    const auto isBetter = []( const Link_t& a, const Link_t& b )
+    {
+      if ( a.rank != b.rank ) return a.rank < b.rank;
+      return a.first < b.first || ( a.first == b.first && a.second < b.second );
+    };
+
+    if ( m_links.size() < maxLines )
+    {
+      m_links.push_back( link );
+      std::ranges::push_heap( m_links, isBetter );
+    }
+    else if ( isBetter( link, m_links.front() ) )
+    {
+      std::ranges::pop_heap( m_links, isBetter );
+      m_links.back() = link;
+      std::ranges::push_heap( m_links, isBetter );
+    }
+  }
+
+  /////////////////////////////////////////////////////////
+  /// PRIVATE
+  const SpatialGrid& ParticleFullMeshLineModifier::getSpatialGrid( const ParticleSpan particles )
+  {
+    if ( m_spatialGrid != nullptr && m_spatialGrid->isBuiltFrom( particles ) )
+      return *m_spatialGrid;
+
+    m_localGrid.rebuild( particles, m_data.maxDistance.first );
+    return m_localGrid;
   }
 }
\ No newline at end of file
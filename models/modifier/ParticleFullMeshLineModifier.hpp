@@ -17,6 +17,7 @@
 
 #include "models/IParticleModifier.hpp"
 #include "models/ShaderMacros.hpp"
+#include "models/SpatialGrid.hpp"
 #include "models/data/PipelineContext.hpp"
 
 namespace nx
@@ -24,7 +25,7 @@ namespace nx
 
   class ParticleFullMeshLineModifier final : public IParticleModifier
   {
-#define PARTICLE_LINE_MODIFIER_PARAMS(X)                                                                   \
+#define FULL_MESH_LINE_MODIFIER_PARAMS(X)                                                                  \
 X(lineThickness,     float,     2.0f,   0.1f,   100.0f,   "Thickness of the curved line",          true)   \
 X(swellFactor,       float,     1.5f,   0.0f,   10.0f,   "Swelling multiplier at midpoint",       true)    \
 X(easeDownInSeconds, float,     1.0f,   0.01f,  10.0f,   "Ease-out fade duration (seconds)",      true)    \
@@ -33,23 +34,28 @@ X(lineColor,         sf::Color, sf::Color(255,255,255,255), 0, 255, "Primary fal
 X(otherLineColor,    sf::Color, sf::Color(255,255,255,255), 0, 255, "Alternate/fading line color", false)  \
 X(invertColorTime,   bool,      false,  0,      1,       "Colors fade in over time rather than out", true) \
 X(curvature,         float,     0.25f,  -NX_PI,  NX_PI,    "Amount of curvature (arc)",             true)  \
-X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in the curve",       true)
+X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in the curve",       true)    \
+X(maxDistance,       float,     150.f,  10.f,   2000.f,  "Longest link drawn",                    true)    \
+X(linkEveryPair,     bool,      false,  0,      1,       "Ignore the distance and link every pair (slow with many particles)", true) \
+X(maxLines,          int32_t,   2000,   1,      20000,   "Most links drawn per frame",            true)    \
+X(preferYoungest,    bool,      false,  0,      1,       "Over budget, keep the newest links instead of the shortest", true) \
+X(connectionStride,  int32_t,   1,      1,      16,      "Only links particles this many apart in spawn order", true)
 
     struct FullMeshLineData_t
     {
       bool isActive { true };
-      EXPAND_SHADER_PARAMS_FOR_STRUCT(PARTICLE_LINE_MODIFIER_PARAMS)
+      EXPAND_SHADER_PARAMS_FOR_STRUCT(FULL_MESH_LINE_MODIFIER_PARAMS)
     };
 
     enum class E_FullMeshModifierParam
     {
-      EXPAND_SHADER_PARAMS_FOR_ENUM(PARTICLE_LINE_MODIFIER_PARAMS)
+      EXPAND_SHADER_PARAMS_FOR_ENUM(FULL_MESH_LINE_MODIFIER_PARAMS)
       LastItem
     };
 
     static inline const std::array<std::string, static_cast<size_t>(E_FullMeshModifierParam::LastItem)> m_paramLabels =
     {
-      EXPAND_SHADER_PARAM_LABELS(PARTICLE_LINE_MODIFIER_PARAMS)
+      EXPAND_SHADER_PARAM_LABELS(FULL_MESH_LINE_MODIFIER_PARAMS)
     };
 
   public:
@@ -57,7 +63,7 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
     explicit ParticleFullMeshLineModifier( PipelineContext& context )
       : m_ctx( context )
     {
-      EXPAND_SHADER_VST_BINDINGS(PARTICLE_LINE_MODIFIER_PARAMS, m_ctx.vstContext.paramBindingManager)
+      EXPAND_SHADER_VST_BINDINGS(FULL_MESH_LINE_MODIFIER_PARAMS, m_ctx.vstContext.paramBindingManager)
     }
 
     nlohmann::json serialize() const override;
@@ -67,6 +73,15 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
     bool isActive() const override { return m_isActive; }
     void processMidiEvent(const Midi_t &midiEvent) override {}
 
+    void setDetailScale( const float detailScale ) override { m_detailScale = detailScale; }
+
+    float getNeighborRadius() const override
+    {
+      return m_data.linkEveryPair.first ? 0.f : m_data.maxDistance.first;
+    }
+
+    void setSpatialGrid( const SpatialGrid * spatialGrid ) override { m_spatialGrid = spatialGrid; }
+
     E_ModifierType getType() const override { return E_ModifierType::E_FullMeshModifier; }
 
     void drawMenu() override;
@@ -75,8 +90,27 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     void modify(
        const sf::BlendMode& blendMode,
-       std::deque< IParticle* >& particles,
-       std::deque< sf::Drawable* >& outArtifacts ) override;
+       ParticleSpan particles,
+       std::vector< sf::Drawable* >& outArtifacts ) override;
+
+  private:
+
+    struct Link_t
+    {
+      uint32_t first { 0 };
+      uint32_t second { 0 };
+
+      // lower is kept first: the squared length or the age of the older particle
+      float rank { 0.f };
+    };
+
+    void collectLinks( ParticleSpan particles );
+
+    // keeps the best links within the budget
+    void addLink( const Link_t& link, size_t maxLines );
+
+    // the pipeline's grid, unless it was built from other particles
+    const SpatialGrid& getSpatialGrid( ParticleSpan particles );
 
   private:
 
@@ -84,6 +118,14 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     bool m_isActive { true };
     FullMeshLineData_t m_data;
+    float m_detailScale { 1.f };
+
+    const SpatialGrid * m_spatialGrid { nullptr };
+    SpatialGrid m_localGrid;
+
+    // a heap on the rank while collecting, so the worst link is always at the front
+    std::vector< Link_t > m_links;
+    std::vector< float > m_ages;
 
   };
 
@@ -63,39 +63,38 @@ namespace nx
   /// PUBLIC
   void ParticleSequentialLineModifier::modify(
      const sf::BlendMode& blendMode,
-     std::deque< IParticle* >& particles,
-     std::deque< sf::Drawable* >& outArtifacts )
+     ParticleSpan particles,
+     std::vector< sf::Drawable* >& outArtifacts )
   {
-    for ( int i = 0; i < particles.size(); ++i )
-    {
-      if ( m_data.isActive && i > 0 )
-      {
-        auto * line = dynamic_cast< CurvedLine* >( outArtifacts.emplace_back(
-          new CurvedLine( particles[ i - 1 ]->getPosition(),
-            particles[ i ]->getPosition(),
-            m_data.curvature.first,
-            m_data.lineSegments.first ) ) );
+    if ( !m_data.isActive || particles.size() < 2 ) return;
+
+    const auto segments = scaleSegments( m_data.lineSegments.first, m_detailScale );
 
-        line->setWidth( m_data.lineThickness.first );
+    auto * lines = new CurvedLineBatch();
+    lines->reserve( particles.size() - 1, segments );
 
-        if ( m_data.useParticleColors.first )
-        {
-          LineHelper::updateLineColors( line,
+    for ( size_t i = 1; i < particles.size(); ++i )
+    {
+      const auto colors = m_data.useParticleColors.first
+        ? LineHelper::getLineColors(
             particles[ i - 1 ],
             particles[ i ],
-            m_data.invertColorTime.first );
-        }
-        else
-        {
-          LineHelper::updateCustomLineColors(
-            line,
+            m_data.invertColorTime.first )
+        : LineHelper::getCustomLineColors(
             particles[ i - 1 ],
             particles[ i ],
             m_data.lineColor.first,
             m_data.otherLineColor.first,
             m_data.invertColorTime.first );
-        }
-      }
+
+      lines->append( particles[ i - 1 ]->getPosition(),
+                     particles[ i ]->getPosition(),
+                     m_data.curvature.first,
+                     segments,
+                     m_data.lineThickness.first,
+                     colors );
     }
+
+    emitLines( lines, outArtifacts );
   }
 } // namespace nx
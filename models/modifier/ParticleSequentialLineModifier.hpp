@@ -66,6 +66,8 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     void processMidiEvent(const Midi_t &midiEvent) override {}
 
+    void setDetailScale( const float detailScale ) override { m_detailScale = detailScale; }
+
     [[nodiscard]]
     nlohmann::json serialize() const override;
 
@@ -78,15 +80,16 @@ X(lineSegments,      int32_t,   20,     1,      200,     "Number of segments in
 
     void modify(
        const sf::BlendMode& blendMode,
-       std::deque< IParticle* >& particles,
-       std::deque< sf::Drawable* >& outArtifacts ) override;
+       ParticleSpan particles,
+       std::vector< sf::Drawable* >& outArtifacts ) override;
 
   private:
 
     PipelineContext& m_ctx;
     bool m_isActive { true };
     SeqLineData_t m_data;
+    float m_detailScale { 1.f };
 
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
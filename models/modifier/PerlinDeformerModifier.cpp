@@ -79,8 +79,8 @@ namespace nx
   /// PUBLIC
   void PerlinDeformerModifier::modify(
      const sf::BlendMode& blendMode,
-     std::deque< IParticle* >& particles,
-     std::deque< sf::Drawable* >& outArtifacts )
+     ParticleSpan particles,
+     std::vector< sf::Drawable* >& outArtifacts )
   {
     for (size_t i = 0; i < particles.size(); ++i)
     {
@@ -185,4 +185,4 @@ namespace nx
     return value;
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
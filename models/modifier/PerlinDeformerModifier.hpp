@@ -85,8 +85,8 @@ X(perlinColor,       sf::Color, sf::Color(255, 255, 255, 100), 0, 255, "Fallback
 
     void modify(
        const sf::BlendMode& blendMode,
-       std::deque< IParticle* >& particles,
-       std::deque< sf::Drawable* >& outArtifacts ) override;
+       ParticleSpan particles,
+       std::vector< sf::Drawable* >& outArtifacts ) override;
 
   private:
 
@@ -115,4 +115,4 @@ X(perlinColor,       sf::Color, sf::Color(255, 255, 255, 100), 0, 255, "Fallback
 
     float m_time { 0.f };
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
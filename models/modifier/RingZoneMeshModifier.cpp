@@ -61,8 +61,8 @@ namespace nx
   /////////////////////////////////////////////////////////
   /// PUBLIC
   void RingZoneMeshModifier::modify(const sf::BlendMode& blendMode,
-                                    std::deque< IParticle * > &particles,
-                                    std::deque< sf::Drawable * > &outArtifacts)
+                                    ParticleSpan particles,
+                                    std::vector< sf::Drawable * > &outArtifacts)
   {
     const sf::Vector2f &center = m_ctx.globalInfo.windowHalfSize;
 
@@ -75,6 +75,12 @@ namespace nx
       rings[ ringIdx ].push_back(p);
     }
 
+    const auto segments = scaleSegments( m_data.lineSegments.first, m_detailScale );
+
+    // about one ring line and one spoke per particle
+    auto * lines = new CurvedLineBatch();
+    lines->reserve( particles.size() * 2, segments );
+
     // Step 2: Draw rings and spokes
     for (auto &[ ringIdx, ringParticles ]: rings)
     {
@@ -95,19 +101,16 @@ namespace nx
           auto *p1 = ringParticles[ i ];
           auto *p2 = ringParticles[ (i + 1) % ringParticles.size() ]; // wrap around
 
-          auto * line = new CurvedLine( p1->getPosition(),
-                                        p2->getPosition(),
-                                        m_data.curvature.first,
-                                        m_data.lineSegments.first );
-
-          line->setWidth( m_data.lineThickness.first );
-
-          if ( p1->getExpirationTimeInSeconds() > p2->getExpirationTimeInSeconds() )
-            setLineColors( line, p1, p2 );
-          else
-            setLineColors( line, p2, p1 );
+          const auto colors = ( p1->getExpirationTimeInSeconds() > p2->getExpirationTimeInSeconds() )
+            ? getLineColors( p1, p2 )
+            : getLineColors( p2, p1 );
 
-          outArtifacts.push_back( line );
+          lines->append( p1->getPosition(),
+                         p2->getPosition(),
+                         m_data.curvature.first,
+                         segments,
+                         m_data.lineThickness.first,
+                         colors );
         }
       }
 
@@ -119,49 +122,44 @@ namespace nx
         for (size_t i = 0; i < minCount; ++i)
         {
 
-          auto * line = new CurvedLine( ringParticles[ i ]->getPosition(),
-                                        prevRing[ i ]->getPosition(),
-                                        m_data.curvature.first,
-                                        m_data.lineSegments.first );
+          const auto colors = ( ringParticles[ i ]->getExpirationTimeInSeconds() > prevRing[ i ]->getExpirationTimeInSeconds() )
+            ? getLineColors( ringParticles[ i ], prevRing[ i ] )
+            : getLineColors( prevRing[ i ], ringParticles[ i ] );
 
-          line->setWidth( m_data.lineThickness.first );
-
-          if ( ringParticles[ i ]->getExpirationTimeInSeconds() > prevRing[ i ]->getExpirationTimeInSeconds() )
-            setLineColors( line, ringParticles[ i ], prevRing[ i ] );
-          else
-            setLineColors( line, prevRing[ i ], ringParticles[ i ] );
-
-          outArtifacts.push_back( line );
+          lines->append( ringParticles[ i ]->getPosition(),
+                         prevRing[ i ]->getPosition(),
+                         m_data.curvature.first,
+                         segments,
+                         m_data.lineThickness.first,
+                         colors );
         }
       }
     }
+
+    emitLines( lines, outArtifacts );
   }
 
 
   /////////////////////////////////////////////////////////
   /// PRIVATE
   /////////////////////////////////////////////////////////
-  void RingZoneMeshModifier::setLineColors( CurvedLine * line,
-                      const IParticle * pointA,
-                      const IParticle * pointB ) const
+  std::pair< sf::Color, sf::Color > RingZoneMeshModifier::getLineColors( const IParticle * pointA,
+                                                                        const IParticle * pointB ) const
   {
 
     if ( m_data.useParticleColors.first )
     {
-      LineHelper::updateLineColors( line,
+      return LineHelper::getLineColors(
         pointA,
         pointB,
         m_data.invertColorTime.first );
     }
-    else
-    {
-      LineHelper::updateCustomLineColors(
-        line,
-        pointA,
-        pointB,
-        m_data.lineColor.first,
-        m_data.otherLineColor.first,
-        m_data.invertColorTime.first );
-    }
+
+    return LineHelper::getCustomLineColors(
+      pointA,
+      pointB,
+      m_data.lineColor.first,
+      m_data.otherLineColor.first,
+      m_data.invertColorTime.first );
   }
 } // namespace nx
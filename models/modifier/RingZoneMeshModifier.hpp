@@ -78,9 +78,11 @@ X(drawSpokes,    bool,    true,     0,      1,        "Toggle drawing of radial
     bool isActive() const override { return m_data.isActive; }
     void processMidiEvent(const Midi_t &) override {}
 
+    void setDetailScale( const float detailScale ) override { m_detailScale = detailScale; }
+
     void modify(const sf::BlendMode& blendMode,
-                std::deque< IParticle * > &particles,
-                std::deque< sf::Drawable * > &outArtifacts) override;
+                ParticleSpan particles,
+                std::vector< sf::Drawable * > &outArtifacts) override;
 
   private:
     static float length(const sf::Vector2f &v) { return std::sqrt(v.x * v.x + v.y * v.y); }
@@ -91,13 +93,14 @@ X(drawSpokes,    bool,    true,     0,      1,        "Toggle drawing of radial
       return std::atan2(d.y, d.x);
     }
 
-    void setLineColors( CurvedLine * line,
-                        const IParticle * pointA,
-                        const IParticle * pointB ) const;
+    [[nodiscard]]
+    std::pair< sf::Color, sf::Color > getLineColors( const IParticle * pointA,
+                                                     const IParticle * pointB ) const;
 
   private:
     PipelineContext& m_ctx;
     RingZoneMeshData_t m_data;
+    float m_detailScale { 1.f };
 
   };
 
@@ -77,26 +77,46 @@ X(falloffExponent,    float       , 0.75f,    0.1f,  4.f, "Exponent for falloff
 
     void applyOnSpawn(IParticle*, const ParticleData_t&) override {}
 
-    void applyOnUpdate(IParticle* p, const sf::Time& dt, const ParticleData_t& particleData) override
+    void applyOnUpdate(const ParticleFields_t& fields, const sf::Time& dt, const ParticleData_t& particleData) override
     {
-      const sf::Vector2f pos = p->getPosition();
-
-      const float energy = p->getEnergy();
-      if (energy < 1e-4f) return;
+      const auto count = fields.size();
+      m_angles.resize( count );
+      m_forces.resize( count );
+
+      float * angles = m_angles.data();
+      float * forces = m_forces.data();
+      float * positionsX = fields.positionsX.data();
+      float * positionsY = fields.positionsY.data();
+      const float * energies = fields.energies.data();
+
+      // the easing isn't vectorizable, so it gets its own loop
+      const float strength = m_data.strength.first * dt.asSeconds();
+      for ( size_t i = 0; i < count; ++i )
+      {
+        // the particles without energy don't move
+        const float energy = energies[ i ];
+        angles[ i ] = ( energy * 360.f + m_data.angleOffset.first ) * NX_D2R;
+        forces[ i ] = energy < 1e-4f ? 0.f : strength * m_easing.getEasing( std::clamp( energy, 0.f, 1.f ) );
+      }
 
-      float angle = energy * 360.f + m_data.angleOffset.first;
-      angle = angle * NX_D2R;
-      const auto normEnergy = std::clamp( energy, 0.f, 1.f );
-      float force = m_data.strength.first * m_easing.getEasing( normEnergy );
       if (m_data.useFalloff.first)
       {
-        const float dist = std::max(length(pos - m_ctx.globalInfo.windowHalfSize), 1.f);
-        force *= 1.f / std::pow(dist, m_data.falloffExponent.first);
+        const sf::Vector2f center = m_ctx.globalInfo.windowHalfSize;
+        const float exponent = m_data.falloffExponent.first;
+        for ( size_t i = 0; i < count; ++i )
+        {
+          const float dx = positionsX[ i ] - center.x;
+          const float dy = positionsY[ i ] - center.y;
+          const float dist = std::max( std::sqrt( dx * dx + dy * dy ), 1.f );
+          forces[ i ] /= std::pow( dist, exponent );
+        }
       }
 
-      const auto dir = sf::Vector2f{std::cos(angle), std::sin(angle)};
-      const auto offset = dir * force * dt.asSeconds();
-      p->move(offset);
+      for ( size_t i = 0; i < count; ++i )
+      {
+        positionsX[ i ] += std::cos( angles[ i ] ) * forces[ i ];
+        positionsY[ i ] += std::sin( angles[ i ] ) * forces[ i ];
+      }
     }
 
     void drawMenu() override
@@ -112,14 +132,13 @@ X(falloffExponent,    float       , 0.75f,    0.1f,  4.f, "Exponent for falloff
     }
 
   private:
-    static float length(const sf::Vector2f& v)
-    {
-      return std::sqrt(v.x * v.x + v.y * v.y);
-    }
-
     PipelineContext m_ctx;
     FlowData_t m_data;
     PercentageEasing m_easing;
+
+    // scratch space for the batched update
+    std::vector< float > m_angles;
+    std::vector< float > m_forces;
   };
 
-} // namespace nx
+} // namespace nx
@@ -41,23 +41,15 @@ namespace nx
     }
   }
 
-  void FreeFallBehavior::applyOnUpdate( IParticle * p,
+  void FreeFallBehavior::applyOnUpdate( const ParticleFields_t& fields,
                                         const sf::Time& deltaTime,
                                         const ParticleData_t& particleData )
   {
-    const float elapsed = p->getTimeAliveInSeconds();
-    const float offset = elapsed * m_data.scrollRate.first;
+    // the longer a particle is alive, the faster it falls
+    const float scrollRate = m_data.invert.first ? -m_data.scrollRate.first : m_data.scrollRate.first;
 
-    p->setPosition({ p->getPosition().x,
-                     m_data.invert.first ? p->getPosition().y - offset
-                                         : p->getPosition().y + offset });
-    // const auto trail = p->getSpawnTimeInSeconds() / m_data.timeDivisor.first;
-    // const float offset = trail * deltaTime.asSeconds();
-    //
-    // if (!m_data.invert.first)
-    //   p->move({0.f, offset});     // Downward scroll
-    // else
-    //   p->move({0.f, -offset});    // Upward scroll
+    for ( size_t i = 0; i < fields.size(); ++i )
+      fields.positionsY[ i ] += fields.timesAlive[ i ] * scrollRate;
   }
 
   void FreeFallBehavior::drawMenu()
@@ -62,7 +62,7 @@ X(scrollRate,   float,  1.f,    0.f,    50.f, "Rate of movement"       , true )
     void applyOnSpawn( IParticle * p,
                        const ParticleData_t& particleData ) override {}
 
-    void applyOnUpdate( IParticle * p,
+    void applyOnUpdate( const ParticleFields_t& fields,
                         const sf::Time& deltaTime,
                         const ParticleData_t& particleData ) override;
 
@@ -44,14 +44,19 @@ namespace nx
   void JitterBehavior::applyOnSpawn( IParticle * p,
                                      const ParticleData_t& particleData )
   {
-    p->setPosition( getJitterPosition( p ) );
+    p->move( getJitterOffset( p->getRadius() ) );
   }
 
-  void JitterBehavior::applyOnUpdate( IParticle * p,
+  void JitterBehavior::applyOnUpdate( const ParticleFields_t& fields,
                                       const sf::Time& deltaTime,
                                       const ParticleData_t& particleData )
   {
-    p->setPosition( getJitterPosition( p ) );
+    for ( size_t i = 0; i < fields.size(); ++i )
+    {
+      const auto offset = getJitterOffset( fields.particles[ i ]->getRadius() );
+      fields.positionsX[ i ] += offset.x;
+      fields.positionsY[ i ] += offset.y;
+    }
   }
 
   void JitterBehavior::drawMenu()
@@ -64,7 +69,7 @@ namespace nx
     }
   }
 
-  sf::Vector2f JitterBehavior::getJitterPosition( const IParticle * p )
+  sf::Vector2f JitterBehavior::getJitterOffset( const float radius )
   {
     // add jitter to the position
     // 1. get the circular offset by calculating a random angle [0 - 360)
@@ -72,13 +77,12 @@ namespace nx
 
     // 2. get the deviation amount
     // we have to add 1.f here to prevent the radius from ever being 0 and having a div/0 error.
-    auto safeRadius = static_cast< uint32_t >( p->getRadius() );
+    auto safeRadius = static_cast< uint32_t >( radius );
     if ( safeRadius == 0 ) ++safeRadius;
 
     const auto jitterAmount = m_data.jitterMultiplier.first *
                                    static_cast< float >( m_rand() % safeRadius );
-    return p->getPosition() +
-      sf::Vector2f { std::cos( jitterAngle ) * jitterAmount, std::sin( jitterAngle ) * jitterAmount };
+    return { std::cos( jitterAngle ) * jitterAmount, std::sin( jitterAngle ) * jitterAmount };
   }
 
 }
\ No newline at end of file
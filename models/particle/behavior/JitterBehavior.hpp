@@ -63,14 +63,14 @@ X(jitterMultiplier  , float, 0.5f, 0.f, 5.f, "Amount of jitter", true)
     void applyOnSpawn( IParticle * p,
                        const ParticleData_t& particleData ) override;
 
-    void applyOnUpdate( IParticle * p,
+    void applyOnUpdate( const ParticleFields_t& fields,
                         const sf::Time& deltaTime,
                         const ParticleData_t& particleData ) override;
 
     void drawMenu() override;
 
   private:
-    sf::Vector2f getJitterPosition( const IParticle * p );
+    sf::Vector2f getJitterOffset( float radius );
 
   private:
       PipelineContext& m_ctx;
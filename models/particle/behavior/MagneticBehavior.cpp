@@ -20,31 +20,51 @@
 namespace nx
 {
 
-  void MagneticBehavior::applyOnUpdate(IParticle * p,
-                                                const sf::Time& dt,
-                                                const ParticleData_t& particleData )
+  void MagneticBehavior::applyOnUpdate(const ParticleFields_t& fields,
+                                       const sf::Time& dt,
+                                       const ParticleData_t& particleData )
   {
-    const sf::Vector2f pos = p->getPosition();
+    const auto count = fields.size();
+    float * positionsX = fields.positionsX.data();
+    float * positionsY = fields.positionsY.data();
 
-    const sf::Vector2f attractor { m_data.magnetLocation.first.x * static_cast< float >(m_ctx.globalInfo.windowSize.x ),
-                                    m_data.magnetLocation.first.y * static_cast< float >(m_ctx.globalInfo.windowSize.y) };
+    const sf::Vector2f attractor = getAttractor();
 
-    const sf::Vector2f dir = attractor - pos;
-    const float distance = std::max(length(dir), 0.001f); // avoid divide by 0
-    const sf::Vector2f normDir = dir / distance;
-
-    // Falloff based on distance
-    float force = m_data.strength.first * 2.f;
-    if (m_data.useFalloff.first)
-      force *= 1.f / std::pow(distance, m_data.falloffExponent.first);
-
-    // Direction: pull or push
+    // pull or push along the direction to the magnet. the loops work on the
+    // position arrays directly, with nothing in them that keeps the compiler
+    // from vectorizing them.
+    float force = m_data.strength.first * 2.f * dt.asSeconds();
     if (!m_data.isAttracting.first)
       force *= -1.f;
 
-    // Apply movement offset
-    const sf::Vector2f offset = normDir * force * dt.asSeconds();
-    p->move( offset );
+    if (m_data.useFalloff.first)
+    {
+      const float exponent = m_data.falloffExponent.first;
+      for ( size_t i = 0; i < count; ++i )
+      {
+        const float dx = attractor.x - positionsX[ i ];
+        const float dy = attractor.y - positionsY[ i ];
+
+        // avoid divide by 0
+        const float distance = std::max( std::sqrt( dx * dx + dy * dy ), 0.001f );
+        const float scale = force / ( distance * std::pow( distance, exponent ) );
+        positionsX[ i ] += dx * scale;
+        positionsY[ i ] += dy * scale;
+      }
+    }
+    else
+    {
+      for ( size_t i = 0; i < count; ++i )
+      {
+        const float dx = attractor.x - positionsX[ i ];
+        const float dy = attractor.y - positionsY[ i ];
+
+        const float distance = std::max( std::sqrt( dx * dx + dy * dy ), 0.001f );
+        const float scale = force / distance;
+        positionsX[ i ] += dx * scale;
+        positionsY[ i ] += dy * scale;
+      }
+    }
   }
 
   void MagneticBehavior::drawMenu()
@@ -91,4 +111,4 @@ namespace nx
   }
 
 
-} // namespace nx
+} // namespace nx
@@ -66,7 +66,7 @@ X(magnetLocation,   sf::Vector2f, sf::Vector2f({0.5f, 0.5f}), 0.f, 0.f, "Locatio
                       const ParticleData_t& particleData ) override
     {}
 
-    void applyOnUpdate(IParticle * p,
+    void applyOnUpdate(const ParticleFields_t& fields,
                        const sf::Time& dt,
                        const ParticleData_t& particleData ) override;
 
@@ -74,9 +74,11 @@ X(magnetLocation,   sf::Vector2f, sf::Vector2f({0.5f, 0.5f}), 0.f, 0.f, "Locatio
 
   private:
 
-    static float length(const sf::Vector2f& v)
+    [[nodiscard]]
+    sf::Vector2f getAttractor() const
     {
-      return std::sqrt(v.x * v.x + v.y * v.y);
+      return { m_data.magnetLocation.first.x * static_cast< float >( m_ctx.globalInfo.windowSize.x ),
+               m_data.magnetLocation.first.y * static_cast< float >( m_ctx.globalInfo.windowSize.y ) };
     }
 
   private:
@@ -81,15 +81,23 @@ X(wavePhaseOffset, float, 0.f,   0.f, NX_TAU, "Wave phase shift", true)
 
     void applyOnSpawn( IParticle * p,
                        const ParticleData_t& particleData ) override
-    {
-      // apply( p );
-    }
+    {}
 
-    void applyOnUpdate( IParticle * p,
+    void applyOnUpdate( const ParticleFields_t& fields,
                         const sf::Time& deltaTime,
                         const ParticleData_t& particleData ) override
     {
-      apply( p );
+      const auto count = fields.size();
+      float * positionsX = fields.positionsX.data();
+      const float * positionsY = fields.positionsY.data();
+
+      const float time = m_ctx.globalInfo.elapsedTimeSeconds;
+      const float timePhase = time * m_data.waveSpeed.first + m_data.wavePhaseOffset.first;
+      const float frequency = m_data.waveFrequency.first;
+      const float amplitude = m_data.waveAmplitude.first;
+
+      for ( size_t i = 0; i < count; ++i )
+        positionsX[ i ] += std::sin( positionsY[ i ] * frequency + timePhase ) * amplitude;
     }
 
     void drawMenu() override
@@ -102,21 +110,6 @@ X(wavePhaseOffset, float, 0.f,   0.f, NX_TAU, "Wave phase shift", true)
       }
     }
 
-  private:
-
-    void apply( IParticle * p )
-    {
-      sf::Vector2f pos = p->getPosition();
-      const float y = pos.y;
-
-      const float time = m_ctx.globalInfo.elapsedTimeSeconds;
-      const float phase = y * m_data.waveFrequency.first + time * m_data.waveSpeed.first;
-      const float offset = std::sin(phase + m_data.wavePhaseOffset.first) * m_data.waveAmplitude.first;
-
-      pos.x += offset;
-      p->setPosition(pos);
-    }
-
   private:
     PipelineContext& m_ctx;
 
@@ -113,7 +113,9 @@ namespace nx
                          m_data.centerOffsetY.first * m_data.centerOffsetY.first } +
         sf::Vector2f(x, y);
 
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -145,7 +147,9 @@ namespace nx
         calibrated +
         sf::Vector2f(x, y);
 
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -154,4 +158,4 @@ namespace nx
     ParticleLayoutBase::notifyBehaviorOnSpawn( p );
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -62,15 +62,14 @@ namespace nx
     }
 
     [[nodiscard]]
-    std::deque< IParticle * > &getParticles() override
+    ParticleSpan getParticles() const override
     {
-      return m_particles;
+      return {};
     }
 
   private:
 
     ParticleData_t m_particleData;
-    std::deque< IParticle * > m_particles;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
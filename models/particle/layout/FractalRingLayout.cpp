@@ -165,16 +165,19 @@ namespace nx
         lastPosition.y + std::sin(angle) * ( ( adjustedRadius + lastRadius ) * m_data.radialSpread.first )
       };
 
-      auto* p = createParticle(midiEvent, adjustedRadius);
-      p->setPosition(pos);
-
-      if ( m_data.enableFractalFades.first )
+      // the ring keeps growing from the position even when the limit turns the particle away
+      if ( auto* p = createParticle(midiEvent, adjustedRadius) )
       {
-        p->setExpirationTimeInSeconds(
-          p->getExpirationTimeInSeconds() - static_cast< int32_t >(
-          m_data.delayFractalFadesMultiplier.first *
-          static_cast< float >(depth) *
-          static_cast< float >(particleData.timeoutInSeconds.first)) );
+        p->setPosition(pos);
+
+        if ( m_data.enableFractalFades.first )
+        {
+          p->setExpirationTimeInSeconds(
+            p->getExpirationTimeInSeconds() - static_cast< int32_t >(
+            m_data.delayFractalFadesMultiplier.first *
+            static_cast< float >(depth) *
+            static_cast< float >(particleData.timeoutInSeconds.first)) );
+        }
       }
 
       spawnFractalRing(
@@ -189,7 +192,9 @@ namespace nx
   IParticle * FractalRingLayout::createParticle( const Midi_t& midiEvent,
                                                  const float adjustedRadius )
   {
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return nullptr;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent,
         m_ctx.globalInfo.elapsedTimeSeconds,
@@ -200,4 +205,4 @@ namespace nx
     return p;
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -98,7 +98,9 @@ namespace nx
 
     for ( int32_t i = 1; i <= m_data.depth.first; ++i )
     {
-      auto * p = m_particles.emplace_back(
+      if ( !m_particles.canSpawn() ) continue;
+
+      auto * p = m_particles.add(
         m_particleGeneratorManager.getParticleGenerator()->createParticle(
           midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -131,8 +131,10 @@ namespace nx
   {
     if ( state.depth <= 0 )
     {
+      if ( !m_particles.canSpawn() ) return;
+
       // Final particle placement
-      auto * p = m_particles.emplace_back(
+      auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent,
         m_ctx.globalInfo.elapsedTimeSeconds ) );
@@ -85,7 +85,9 @@ namespace nx
     const float x = ( static_cast< float >( m_ctx.globalInfo.windowSize.x ) * m_data.phaseSpread.first ) * sin(a * localT + m_data.phaseDelta.first);
     const float y = ( static_cast< float >( m_ctx.globalInfo.windowSize.y ) * m_data.phaseSpread.first ) * sin(b * localT);
 
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -108,4 +110,4 @@ namespace nx
   // }
 
 
-}
\ No newline at end of file
+}
\ No newline at end of file
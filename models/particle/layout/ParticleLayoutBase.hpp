@@ -17,12 +17,13 @@
 
 #include "models/IParticleLayout.hpp"
 
-#include "helpers/ColorHelper.hpp"
+#include "helpers/ColorFadeKernel.hpp"
 
 #include "models/ParticleBehaviorPipeline.hpp"
 #include "models/easings/PercentageEasing.hpp"
 
 #include "models/ParticleGeneratorManager.hpp"
+#include "models/ParticleStore.hpp"
 
 namespace nx
 {
@@ -42,41 +43,25 @@ namespace nx
         m_particleGeneratorManager( context )
     {}
 
-    ~ParticleLayoutBase() override
-    {
-      for ( const auto * particle : m_particles )
-        delete particle;
-    }
+    ~ParticleLayoutBase() override = default;
 
     void update( const sf::Time &deltaTime ) override
     {
-      for ( auto i = 0; i < m_particles.size(); ++i )
-      {
-        IParticle * timeParticle = m_particles[ i ];
-
-        timeParticle->update( deltaTime );
-
-        if ( !timeParticle->hasExpired() )
-        {
-          const auto percentage = timeParticle->getTimeRemainingPercentage(); //m_fadeEasing.getEasing( 1.f - timeParticle->getTimeRemainingPercentage() );
-
-          updateFillColor( timeParticle, percentage );
-          updateOutlineColor( timeParticle, percentage );
-
-          // notify the behavior pipeline that we've updated a particle
-          // this notification occurs automatically but the OnSpawn one does not
-          // see notifyBehaviorOnSpawn(...)
-          m_behaviorPipeline.applyOnUpdate(
-            timeParticle,
-            deltaTime,
-            m_particleGeneratorManager.getParticleGenerator()->getData() );
-        }
-        else
-        {
-          delete m_particles[ i ];
-          m_particles.erase( m_particles.begin() + i );
-        }
-      }
+      // drops the expired particles, so everything left is alive
+      m_particles.update( deltaTime );
+
+      updateColors( m_particles.getLifePercentages() );
+
+      // notify the behavior pipeline that we've updated the particles
+      // this notification occurs automatically but the OnSpawn one does not
+      // see notifyBehaviorOnSpawn(...)
+      m_behaviorPipeline.applyOnUpdate(
+        m_particles.getFields(),
+        deltaTime,
+        m_particleGeneratorManager.getParticleGenerator()->getData() );
+
+      // the behaviors only moved the arrays
+      m_particles.syncParticles();
     }
 
     [[nodiscard]]
@@ -86,7 +71,11 @@ namespace nx
     }
 
     [[nodiscard]]
-    std::deque< IParticle * >& getParticles() override { return m_particles; }
+    ParticleSpan getParticles() const override { return m_particles.getSpan(); }
+
+    void setParticleLimit( const ParticleLimit_t& limit ) override { m_particles.setLimit( limit ); }
+
+    size_t takeDroppedParticleCount() override { return m_particles.takeDroppedCount(); }
 
   protected:
 
@@ -105,49 +94,62 @@ namespace nx
     PercentageEasing& getEasing() { return m_fadeEasing; }
 
   private:
-    virtual void updateFillColor( IParticle * particle, const float percentage )
+    // fades every particle toward the background as it ages. the colors are worked
+    // out for all the particles at once and only then handed to each particle.
+    void updateColors( const std::span< const float > percentages )
     {
       const auto& particleData =
         m_particleGeneratorManager.getParticleGenerator()->getData();
 
-      const auto nextStartColor =
-        ColorHelper::getNextColor(
-          particleData.fillStartColor.first,
-          sf::Color::Black, // the bg color: which ought to be adjustable
-          percentage );
+      const bool wasFadingInShader = m_isFadingInShader;
+      m_isFadingInShader = particleData.fadeInShader.first;
 
-      const auto nextEndColor =
-        ColorHelper::getNextColor(
-          particleData.fillEndColor.first,
-          sf::Color::Black,
-          percentage );
+      // the particles keep their base colors and fade while being drawn
+      if ( m_isFadingInShader )
+      {
+        // the cpu left them partly faded, which the shader would fade all over again
+        if ( !wasFadingInShader )
+          resetColors( particleData );
 
-      particle->setColorPattern( nextStartColor, nextEndColor );
-    }
+        return;
+      }
 
-    virtual void updateOutlineColor( IParticle * particle, const float percentage )
-    {
-      const auto& particleData =
-        m_particleGeneratorManager.getParticleGenerator()->getData();
+      const auto count = percentages.size();
+      m_fadedColors.resize( count * 4 );
+
+      const std::span fadedColors { m_fadedColors };
+      const auto fillStartColors = fadedColors.subspan( 0, count );
+      const auto fillEndColors = fadedColors.subspan( count, count );
+      const auto outlineStartColors = fadedColors.subspan( count * 2, count );
+      const auto outlineEndColors = fadedColors.subspan( count * 3, count );
 
-      const auto nextStartColor =
-        ColorHelper::getNextColor(
-          particleData.outlineStartColor.first,
-          sf::Color::Black,
-          percentage );
+      // the bg color: which ought to be adjustable
+      const auto bgColor = sf::Color::Black;
 
-      const auto nextEndColor =
-        ColorHelper::getNextColor(
-          particleData.outlineEndColor.first,
-          sf::Color::Black,
-          percentage );
+      ColorFadeKernel::fade( particleData.fillStartColor.first, bgColor, percentages, fillStartColors );
+      ColorFadeKernel::fade( particleData.fillEndColor.first, bgColor, percentages, fillEndColors );
+      ColorFadeKernel::fade( particleData.outlineStartColor.first, bgColor, percentages, outlineStartColors );
+      ColorFadeKernel::fade( particleData.outlineEndColor.first, bgColor, percentages, outlineEndColors );
 
-      particle->setOutlineColorPattern( nextStartColor, nextEndColor );
+      for ( size_t i = 0; i < count; ++i )
+      {
+        m_particles[ i ]->setColorPattern( fillStartColors[ i ], fillEndColors[ i ] );
+        m_particles[ i ]->setOutlineColorPattern( outlineStartColors[ i ], outlineEndColors[ i ] );
+      }
+    }
+
+    void resetColors( const ParticleData_t& particleData )
+    {
+      for ( auto * particle : m_particles.getSpan() )
+      {
+        particle->setColorPattern( particleData.fillStartColor.first, particleData.fillEndColor.first );
+        particle->setOutlineColorPattern( particleData.outlineStartColor.first, particleData.outlineEndColor.first );
+      }
     }
 
   protected:
     PipelineContext& m_ctx;
-    std::deque< IParticle * > m_particles;
+    ParticleStore m_particles;
 
     TParticleData m_data;
 
@@ -156,6 +158,12 @@ namespace nx
 
     PercentageEasing m_fadeEasing;
 
+    // fill start, fill end, outline start, outline end: one run of colors per particle each
+    std::vector< sf::Color > m_fadedColors;
+
+    // the fade mode of the last update, to catch the option being switched
+    bool m_isFadingInShader { false };
+
     sf::BlendMode m_blendMode { sf::BlendAdd };
   };
 
@@ -133,7 +133,9 @@ X(enableMirroring,  bool,    true,   0,      1,      "Mirror waveform across hor
 
         auto spawnParticle = [&](float posY)
         {
-          auto* particle = m_particles.emplace_back(
+          if ( !m_particles.canSpawn() ) return;
+
+          auto* particle = m_particles.add(
             m_particleGeneratorManager.getParticleGenerator()->createParticle(energy, m_ctx.globalInfo.elapsedTimeSeconds)
           );
           particle->setPosition({ x, posY });
@@ -185,4 +187,4 @@ X(enableMirroring,  bool,    true,   0,      1,      "Mirror waveform across hor
     MaxEnergyTracker m_recentMax;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -66,7 +66,9 @@ namespace nx
 
   void RandomParticleLayout::addMidiEvent(const Midi_t &midiEvent)
   {
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -74,4 +76,4 @@ namespace nx
     ParticleLayoutBase::notifyBehaviorOnSpawn( p );
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
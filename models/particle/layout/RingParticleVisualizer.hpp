@@ -122,8 +122,11 @@ X(threshold,       float, 0.1f,   0.f,   1.f,    "Minimum level required to trig
           m_ctx.globalInfo.windowHalfSize.y + std::sin( angle ) * radius
         };
 
+        if ( !m_particles.canSpawn() )
+          continue;
+
         auto * particle =
-          m_particles.emplace_back(
+          m_particles.add(
             m_particleGeneratorManager.getParticleGenerator()->createParticle( mag, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
         particle->setPosition( pos );
@@ -178,4 +181,4 @@ X(threshold,       float, 0.1f,   0.f,   1.f,    "Minimum level required to trig
     TimedCursorPosition m_timedCursor;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -124,14 +124,15 @@ X(mirrorSkewRotation,   float,  0.f,   -NX_PI, NX_PI,"Skew rotation for mirror c
         const float angle = static_cast<float>(i) * ( baseAngleStep + m_data.skewRotation.first ) + m_data.rotationOffset.first;
         const float radius = spiralStartRadius + spiralTightness * static_cast< float >(i) + eased * m_data.radiusMod.first;
 
-        { // clockwise spiral
+        if ( m_particles.canSpawn() ) // clockwise spiral
+        {
           const sf::Vector2f pos =
           {
             center.x + std::cos(angle) * radius,
             center.y + std::sin(angle) * radius
           };
 
-          auto* particle = m_particles.emplace_back(
+          auto* particle = m_particles.add(
             m_particleGeneratorManager.getParticleGenerator()->createParticle(energy, m_ctx.globalInfo.elapsedTimeSeconds));
 
           particle->setPosition(pos);
@@ -139,7 +140,7 @@ X(mirrorSkewRotation,   float,  0.f,   -NX_PI, NX_PI,"Skew rotation for mirror c
         }
 
         // mirror counter-clockwise spiral
-        if ( m_data.mirrorSpiral.first )
+        if ( m_data.mirrorSpiral.first && m_particles.canSpawn() )
         {
           const float mirrorEnergy = energy * m_data.mirrorGainFactor.first;
           const float mirrorRadius = radius + m_data.mirrorRadialOffset.first;
@@ -151,7 +152,7 @@ X(mirrorSkewRotation,   float,  0.f,   -NX_PI, NX_PI,"Skew rotation for mirror c
             center.y + std::sin(mirroredAngle) * mirrorRadius
           };
 
-          auto* mirror = m_particles.emplace_back(
+          auto* mirror = m_particles.add(
             m_particleGeneratorManager.getParticleGenerator()->createParticle(mirrorEnergy, m_ctx.globalInfo.elapsedTimeSeconds));
           mirror->setPosition(mirrorPos);
           ParticleLayoutBase::notifyBehaviorOnSpawn(mirror);
@@ -195,4 +196,4 @@ X(mirrorSkewRotation,   float,  0.f,   -NX_PI, NX_PI,"Skew rotation for mirror c
     MaxEnergyTracker m_recentMax;
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -50,7 +50,9 @@ namespace nx
 
   void SpiralParticleLayout::addMidiEvent(const Midi_t &midiEvent)
   {
-    auto * p = m_particles.emplace_back(
+    if ( !m_particles.canSpawn() ) return;
+
+    auto * p = m_particles.add(
       m_particleGeneratorManager.getParticleGenerator()->createParticle(
         midiEvent, m_ctx.globalInfo.elapsedTimeSeconds ) );
 
@@ -92,4 +94,4 @@ namespace nx
              m_ctx.globalInfo.windowHalfSize.y + position.y };
   }
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -128,7 +128,9 @@ X(threshold, float,   0.1f, 0.f, 1.f,  "Minimum value before triggering response
             static_cast< float >(row) * cellH + 0.5f * cellH
           };
 
-          auto * p = m_particles.emplace_back(
+          if ( !m_particles.canSpawn() ) continue;
+
+          auto * p = m_particles.add(
             m_particleGeneratorManager.getParticleGenerator()->createParticle(
               eased, m_ctx.globalInfo.elapsedTimeSeconds));
 
@@ -169,4 +171,4 @@ X(threshold, float,   0.1f, 0.f, 1.f,  "Minimum value before triggering response
     RingBufferAverager m_timedBuffer;
     MaxEnergyTracker m_recentMaxEnergy;
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
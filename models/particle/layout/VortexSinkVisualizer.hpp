@@ -184,7 +184,9 @@ public:
         center.y + std::sin(angle) * radius
       };
 
-      auto* p = m_particles.emplace_back(
+      if ( !m_particles.canSpawn() ) continue;
+
+      auto* p = m_particles.add(
         m_particleGeneratorManager.getParticleGenerator()->createParticle(mag, m_ctx.globalInfo.elapsedTimeSeconds));
       p->setPosition(pos);
 
@@ -19,14 +19,14 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Transformable.hpp>
-#include <SFML/Graphics/VertexArray.hpp>
-
-#include "helpers/ColorHelper.hpp"
 
 #include "models/IParticle.hpp"
+#include "models/ParticleBatch.hpp"
+#include "models/ParticlePool.hpp"
 #include "models/data/ParticleData_t.hpp"
 
 #include "models/particle/particles/TimedParticleBase.hpp"
+#include "models/particle/particles/UnitCircleTable.hpp"
 
 namespace nx
 {
@@ -39,23 +39,25 @@ namespace nx
 
     CircleParticle( const ParticleData_t& data,
                     const float spawnTimeStampInSeconds )
-      : m_data( data ),
-        m_radiusOverride( m_data.radius.first )
-    {
-      m_spawnTimeInSeconds = spawnTimeStampInSeconds;
-      update();
-    }
+      : CircleParticle( data, spawnTimeStampInSeconds, data.radius.first )
+    {}
 
     CircleParticle( const ParticleData_t& data,
                     const float spawnTimeStampInSeconds,
                     const float radiusOverride )
       : m_data( data ),
-        m_radiusOverride( radiusOverride )
+        m_circle( &UnitCircleTable::get( data.pointCount.first ) ),
+        m_radiusOverride( radiusOverride ),
+        m_outlineThickness( data.outlineThickness.first )
     {
       m_spawnTimeInSeconds = spawnTimeStampInSeconds;
-      update();
+      updateBounds();
     }
 
+    // the memory comes out of the channel's particle pool
+    static void * operator new( const size_t size ) { return ParticlePool::allocate( size ); }
+    static void operator delete( void * memory ) { ParticlePool::deallocate( memory ); }
+
     CircleParticle(const CircleParticle &other) = delete;
     CircleParticle & operator=( const CircleParticle& other ) = delete;
     CircleParticle( CircleParticle&& other ) = delete;
@@ -83,7 +85,7 @@ namespace nx
 
     void setColorPattern(  const sf::Color & startColor, const sf::Color & endColor ) override
     {
-      updateVertexColors( m_vertices, startColor, endColor );
+      m_fillColors = { startColor, endColor };
     }
 
     [[nodiscard]]
@@ -100,158 +102,65 @@ namespace nx
 
     void setOutlineColorPattern( const sf::Color & startColor, const sf::Color & endColor ) override
     {
-      updateVertexColors( m_outlineVertices, startColor, endColor );
+      m_outlineColors = { startColor, endColor };
     }
 
-    void draw(sf::RenderTarget &target, sf::RenderStates states) const override
+    void appendTo( ParticleBatch& batch ) const override
     {
-      states.transform *= getTransform();
-      states.coordinateType = sf::CoordinateType::Pixels;
+      const auto& transform = getTransform();
+      const sf::Vector2f origin { m_radiusOverride, m_radiusOverride };
+      const auto fade = m_data.fadeInShader.first ? getShaderFade() : 0.f;
 
-      // Render the inside
-      target.draw(m_vertices, states);
+      batch.appendDisc( *m_circle, transform, origin, m_radiusOverride, m_fillColors, fade );
 
-      // Render the outline
-      if (m_data.outlineThickness.first != 0)
+      if ( m_outlineThickness != 0.f )
       {
-        states.texture = nullptr;
-        target.draw(m_outlineVertices, states);
+        batch.appendBand( *m_circle,
+                          transform,
+                          origin,
+                          m_radiusOverride,
+                          m_radiusOverride + m_outlineThickness * m_circle->miterScale,
+                          m_outlineColors,
+                          fade );
       }
     }
 
-  private:
-
-    sf::Vector2f getPointPosition(const uint8_t index) const
+    void draw(sf::RenderTarget &target, sf::RenderStates states) const override
     {
-      const auto angle =
-      static_cast< float >(index) / static_cast< float >(m_data.pointCount.first) * sf::degrees(360.f) - sf::degrees(90.f);
-
-      return sf::Vector2f(m_radiusOverride, m_radiusOverride) +
-             sf::Vector2f(m_radiusOverride, angle);
+      states.coordinateType = sf::CoordinateType::Pixels;
+      ParticleBatch::drawParticle( *this, target, states );
     }
 
-    void update()
-    {
-      const auto count = getPointCount();
-      if (count < 3)
-      {
-        m_vertices.clear();
-        m_outlineVertices.clear();
-        return;
-      }
-
-      // + 2 for the center and repeated first point
-      m_vertices.resize(count + 2);
-
-      // Position
-      for (auto i = 0; i < count; ++i)
-        m_vertices[ i + 1 ].position = getPointPosition(i);
-
-      m_vertices[ count + 1 ].position = m_vertices[ 1 ].position;
-
-      // Update the bounding rectangle
-      m_vertices[ 0 ] = m_vertices[ 1 ]; // so that the result of getBounds() is correct
-      m_insideBounds = m_vertices.getBounds();
-
-      // Compute the center and make it the first vertex
-      m_vertices[ 0 ].position = m_insideBounds.getCenter();
-
-      // Outline
-      updateOutline();
-    }
+  private:
 
-    void updateOutline()
+    void updateBounds()
     {
-      // Return if there is no outline
-      if (m_data.outlineThickness.first == 0.f)
+      if ( m_circle->directions.size() < 4 )
       {
-        m_outlineVertices.clear();
-        m_bounds = m_insideBounds;
+        m_bounds = {};
         return;
       }
 
-      const std::size_t count = m_vertices.getVertexCount() - 2;
-      m_outlineVertices.resize((count + 1) * 2);
+      // an outline on the inside doesn't add to the bounds
+      const auto extent =
+        std::max( m_radiusOverride, m_radiusOverride + m_outlineThickness * m_circle->miterScale );
 
-      for (std::size_t i = 0; i < count; ++i)
-      {
-        const std::size_t index = i + 1;
-
-        // Get the two segments shared by the current point
-        const auto p0 = (i == 0) ? m_vertices[ count ].position : m_vertices[ index - 1 ].position;
-        const auto p1 = m_vertices[ index ].position;
-        const auto p2 = m_vertices[ index + 1 ].position;
-
-        // Compute their normal
-        auto n1 = computeNormal(p0, p1);
-        auto n2 = computeNormal(p1, p2);
-
-        // Make sure that the normals point towards the outside of the shape
-        // (this depends on the order in which the points were defined)
-        if (n1.dot(m_vertices[ 0 ].position - p1) > 0)
-          n1 = -n1;
-        if (n2.dot(m_vertices[ 0 ].position - p1) > 0)
-          n2 = -n2;
-
-        // Combine them to get the extrusion direction
-        const auto factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
-        const auto normal = (n1 + n2) / factor;
-
-        // Update the outline points
-        m_outlineVertices[ i * 2 + 0 ].position = p1;
-        m_outlineVertices[ i * 2 + 1 ].position = p1 + normal * m_data.outlineThickness.first;
-      }
-
-      // Duplicate the first point at the end, to close the outline
-      m_outlineVertices[ count * 2 + 0 ].position = m_outlineVertices[ 0 ].position;
-      m_outlineVertices[ count * 2 + 1 ].position = m_outlineVertices[ 1 ].position;
-
-      // Update the shape's bounds
-      m_bounds = m_outlineVertices.getBounds();
-    }
-
-    static void updateVertexColors( sf::VertexArray & vertexArray,
-                                    const sf::Color & startColor,
-                                    const sf::Color & endColor )
-    {
-
-      const auto n = static_cast< int32_t >( vertexArray.getVertexCount() );
-      const auto nf = static_cast< float >( vertexArray.getVertexCount() );
-      for ( int32_t i = 0, y = n - 1; i < n / 2; ++i, --y )
-      {
-        const float percentage = static_cast< float >( i + 1 ) / nf;
-        const auto currentColor = ColorHelper::lerpColor( startColor, endColor, percentage );
-        vertexArray[ i ].color = currentColor;
-        vertexArray[ y ].color = currentColor;
-      }
-
-      if ( n % 2 == 1 )
-      {
-        const int32_t mid = ( n / 2 - 1 );
-        const float percentage  = static_cast< float >( mid ) / nf;
-        vertexArray[ mid ].color = ColorHelper::lerpColor( startColor, endColor, percentage );
-      }
-    }
-
-    // Compute the normal of a segment
-    static sf::Vector2f computeNormal(const sf::Vector2f p1, const sf::Vector2f p2)
-    {
-      auto normal = (p2 - p1).perpendicular();
-      const float length = normal.length();
-      if (length != 0.f)
-        normal /= length;
-      return normal;
+      m_bounds = { sf::Vector2f { m_radiusOverride, m_radiusOverride } + m_circle->bounds.position * extent,
+                   m_circle->bounds.size * extent };
     }
 
   private:
 
     const ParticleData_t& m_data;
+
+    // the shape is fixed when the particle is created
+    const UnitCircle_t * const m_circle;
     const float m_radiusOverride { 0.f };
+    const float m_outlineThickness { 0.f };
 
-    sf::VertexArray m_vertices        { sf::PrimitiveType::TriangleFan   };
-    sf::VertexArray m_outlineVertices { sf::PrimitiveType::TriangleStrip };
+    std::pair< sf::Color, sf::Color > m_fillColors { sf::Color::White, sf::Color::White };
+    std::pair< sf::Color, sf::Color > m_outlineColors { sf::Color::White, sf::Color::White };
 
-    sf::FloatRect m_insideBounds;
     sf::FloatRect m_bounds;
   };
-} // namespace nx
+} // namespace nx
@@ -15,10 +15,11 @@
 
 #pragma once
 
-#include <SFML/Graphics/VertexArray.hpp>
-
 #include "models/particle/particles/TimedParticleBase.hpp"
+#include "models/particle/particles/UnitCircleTable.hpp"
 #include "models/data/ParticleData_t.hpp"
+#include "models/ParticleBatch.hpp"
+#include "models/ParticlePool.hpp"
 
 #include "helpers/MathHelper.hpp"
 
@@ -41,26 +42,25 @@ X(width,  float, 10.f, 0.f, 150.f,   "Ring width", true)
 
     RingParticle( const RingParticleData_t& data,
                   const float timeStamp )
-      : m_data( data ),
-        m_radiusOverride( data.radius.first ),
-        m_ring( sf::PrimitiveType::TriangleStrip, data.pointCount.first * 2 + 2 )
-    {
-      m_spawnTimeInSeconds = timeStamp;
-      updateShape();
-      setColorPattern( m_data.fillStartColor.first, m_data.fillEndColor.first );
-    }
+      : RingParticle( data, timeStamp, data.radius.first )
+    {}
 
     RingParticle( const RingParticleData_t& data,
                   const float spawnTimeStampInSeconds,
                   const float radiusOverride )
       : m_data( data ),
-        m_radiusOverride( radiusOverride )
+        m_circle( &UnitCircleTable::get( data.pointCount.first ) ),
+        m_radiusOverride( radiusOverride ),
+        m_innerRadius( radiusOverride - data.width.first )
     {
       m_spawnTimeInSeconds = spawnTimeStampInSeconds;
-      updateShape();
       setColorPattern( m_data.fillStartColor.first, m_data.fillEndColor.first );
     }
 
+    // the memory comes out of the channel's particle pool
+    static void * operator new( const size_t size ) { return ParticlePool::allocate( size ); }
+    static void operator delete( void * memory ) { ParticlePool::deallocate( memory ); }
+
     RingParticle(const RingParticle &other) = delete;
     RingParticle & operator=( const RingParticle& other ) = delete;
     RingParticle( RingParticle&& other ) = delete;
@@ -82,32 +82,20 @@ X(width,  float, 10.f, 0.f, 150.f,   "Ring width", true)
 
     sf::FloatRect getLocalBounds() const override
     {
-      return m_ring.getBounds();
+      // the inner radius goes negative when the ring is wider than it is big
+      const auto extent = std::max( std::abs( m_radiusOverride ), std::abs( m_innerRadius ) );
+      return getRingTransform().transformRect(
+        { m_circle->bounds.position * extent, m_circle->bounds.size * extent } );
     }
 
     sf::FloatRect getGlobalBounds() const override
     {
-      return getTransform().transformRect( m_ring.getBounds() );
+      return getTransform().transformRect( getLocalBounds() );
     }
 
     void setColorPattern( const sf::Color & startColor, const sf::Color & endColor ) override
     {
-      const auto n = static_cast< int32_t >(m_ring.getVertexCount());
-      const auto nf = static_cast< float >( m_ring.getVertexCount() );
-      for ( int32_t i = 0, y = n - 1; i < n / 2; ++i, --y )
-      {
-        const float percentage = static_cast< float >(i + 1) / nf;
-        const auto currentColor = ColorHelper::lerpColor( startColor, endColor, percentage );
-        m_ring[ i ].color = currentColor;
-        m_ring[ y ].color = currentColor;
-      }
-
-      if ( n % 2 == 1 )
-      {
-        const int32_t mid = ( n / 2 - 1 );
-        const float percentage  = static_cast< float >( mid ) / nf;
-        m_ring[ mid ].color = ColorHelper::lerpColor( startColor, endColor, percentage );
-      }
+      m_colors = { startColor, endColor };
     }
 
     std::pair< sf::Color, sf::Color > getColors() const override
@@ -125,41 +113,40 @@ X(width,  float, 10.f, 0.f, 150.f,   "Ring width", true)
       return std::make_pair( m_data.outlineStartColor.first, m_data.outlineEndColor.first );
     }
 
+    void appendTo( ParticleBatch& batch ) const override
+    {
+      batch.appendBand( *m_circle,
+                        getTransform() * getRingTransform(),
+                        {},
+                        m_radiusOverride,
+                        m_innerRadius,
+                        m_colors,
+                        m_data.fadeInShader.first ? getShaderFade() : 0.f );
+    }
+
     void draw(sf::RenderTarget& target, sf::RenderStates states) const override
     {
-      states.transform *= getTransform();
-      target.draw(m_ring, states);
+      ParticleBatch::drawParticle( *this, target, states );
     }
 
   private:
 
-    void updateShape()
+    // the unit circles start at the top, rings start on the right
+    static sf::Transform getRingTransform()
     {
-      // -2 because we have to get the final segment of the circle to connect
-      // back to the starting 2
-      const float angle = NX_TAU / ( static_cast< float >(m_ring.getVertexCount()) - 2 );
-
-      for ( int i = 0; i < m_ring.getVertexCount(); i += 2 )
-      {
-        const float theta = static_cast< float >(i) * angle;
-        const float x = std::cos( theta );
-        const float y = std::sin( theta );
-
-        // outer
-        m_ring[ i ].position = { m_radiusOverride * x, m_radiusOverride * y };
-
-        // inner
-        m_ring[ i + 1 ].position = { ( m_radiusOverride - m_data.width.first ) * x,
-                                     ( m_radiusOverride - m_data.width.first ) * y };
-      }
+      return sf::Transform().rotate( sf::degrees( 90.f ) );
     }
 
   private:
 
     const RingParticleData_t& m_data;
-    float m_radiusOverride { 0.f };
 
-    sf::VertexArray m_ring;
+    // the shape is fixed when the particle is created
+    const UnitCircle_t * const m_circle;
+    const float m_radiusOverride { 0.f };
+    const float m_innerRadius { 0.f };
+
+    std::pair< sf::Color, sf::Color > m_colors;
   };
 
-}
\ No newline at end of file
+}
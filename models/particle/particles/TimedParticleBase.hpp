@@ -36,9 +36,9 @@ namespace nx
 
     float getTimeAliveInSeconds() const override { return m_timeAliveInSeconds; }
 
-    void update( const sf::Time& deltaTime ) override
+    void setTimeAliveInSeconds( const float timeAliveInSeconds ) override
     {
-      m_timeAliveInSeconds += deltaTime.asSeconds();
+      m_timeAliveInSeconds = timeAliveInSeconds;
     }
 
     float getSpawnTimeInSeconds() const override
@@ -63,6 +63,15 @@ namespace nx
 
   protected:
 
+    // how far the particle has faded when the fading is left to the shader.
+    // clones that never got an expiration time don't fade.
+    [[nodiscard]]
+    float getShaderFade() const
+    {
+      const auto percentage = getTimeRemainingPercentage();
+      return percentage > 0.f ? std::min( percentage, 1.f ) : 0.f;
+    }
+
     float m_spawnTimeInSeconds { 0.f };
     float m_expirationTimeInSeconds { 0.f };
     float m_timeAliveInSeconds { 0.f };
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Angle.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "helpers/MathHelper.hpp"
+
+namespace nx
+{
+
+  // the geometry every round particle with the same point count shares
+  struct UnitCircle_t
+  {
+    // point 0 is at the top. the last point repeats the first one so that the
+    // shapes close, which makes pointCount + 1 of them.
+    std::vector< sf::Vector2f > directions;
+
+    // where each vertex sits on the color gradient: the filled shape is the
+    // center followed by the rim, and bands have two vertices per rim point
+    std::vector< float > fanWeights;
+    std::vector< float > bandWeights;
+
+    // how far the rim moves per unit of outline thickness, so that
+    // the outline keeps its thickness along the edges
+    float miterScale { 0.f };
+
+    // of the rim at radius 1
+    sf::FloatRect bounds;
+  };
+
+  ///
+  /// Precomputed unit circles by point count. The particles scale and translate
+  /// these when they're drawn, so creating or cloning a particle doesn't do any
+  /// trig, and particles don't have to carry vertex arrays around.
+  class UnitCircleTable final
+  {
+  public:
+
+    // built the first time a point count is asked for, from whichever thread
+    [[nodiscard]]
+    static const UnitCircle_t& get( const uint8_t pointCount )
+    {
+      static std::array< UnitCircle_t, TABLE_SIZE > circles;
+      static std::array< std::once_flag, TABLE_SIZE > flags;
+
+      std::call_once( flags[ pointCount ], [ pointCount ]
+      {
+        build( circles[ pointCount ], pointCount );
+      } );
+
+      return circles[ pointCount ];
+    }
+
+  private:
+
+    static void build( UnitCircle_t& circle, const uint8_t pointCount )
+    {
+      if ( pointCount == 0 ) return;
+
+      circle.directions.resize( pointCount + 1 );
+      for ( uint8_t i = 0; i < pointCount; ++i )
+      {
+        const auto angle =
+          static_cast< float >( i ) / static_cast< float >( pointCount ) * sf::degrees( 360.f ) - sf::degrees( 90.f );
+        circle.directions[ i ] = sf::Vector2f( 1.f, angle );
+      }
+
+      circle.directions[ pointCount ] = circle.directions[ 0 ];
+
+      // the gradient runs from both ends toward the middle
+      fillWeights( circle.fanWeights, pointCount + 2 );
+      fillWeights( circle.bandWeights, ( pointCount + 1 ) * 2 );
+
+      // the normals of two neighboring edges add up to the direction of the
+      // point between them, stretched by 1 / cos( half the angle per edge )
+      if ( pointCount >= 3 )
+        circle.miterScale = 1.f / std::cos( NX_PI / static_cast< float >( pointCount ) );
+
+      sf::Vector2f min = circle.directions[ 0 ];
+      sf::Vector2f max = circle.directions[ 0 ];
+      for ( const auto& direction : circle.directions )
+      {
+        min = { std::min( min.x, direction.x ), std::min( min.y, direction.y ) };
+        max = { std::max( max.x, direction.x ), std::max( max.y, direction.y ) };
+      }
+
+      circle.bounds = { min, max - min };
+    }
+
+    static void fillWeights( std::vector< float >& weights, const size_t count )
+    {
+      weights.resize( count );
+
+      const auto countf = static_cast< float >( count );
+      for ( size_t i = 0; i < count; ++i )
+        weights[ i ] = static_cast< float >( std::min( i, count - 1 - i ) + 1 ) / countf;
+    }
+
+  private:
+
+    static constexpr size_t TABLE_SIZE = 256;
+  };
+
+}
@@ -91,6 +91,9 @@ X(mixFactor,  float,        1.0f,   0.f,  1.f,    "Mix between original and effe
     [[nodiscard]]
     bool isShaderActive() const override { return m_data.isActive; }
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader(const sf::RenderTexture * inputTexture) override;
 
@@ -152,4 +155,4 @@ void main() {
     gl_FragColor = color;
 })";
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
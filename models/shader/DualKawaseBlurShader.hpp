@@ -95,6 +95,12 @@ X(mixFactor,   float, 1.0f,  0.0f, 1.f,   "Blend factor between base and blurred
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
+    [[nodiscard]]
+    bool isOptional() const override { return true; }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader(const sf::RenderTexture * inputTexture) override;
 
@@ -158,4 +164,4 @@ void main()
 )";
 
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
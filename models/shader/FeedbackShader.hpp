@@ -89,6 +89,12 @@ X(mixFactor,         float, 1.0f,    0.f,   1.f, "Mix between original and effec
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
+    [[nodiscard]]
+    bool hasFeedback() const override { return true; }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader(const sf::RenderTexture * inputTexture) override;
 
@@ -107,4 +113,4 @@ X(mixFactor,         float, 1.0f,    0.f,   1.f, "Mix between original and effec
     TimeEasing m_easing;
 
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -107,6 +107,12 @@ X(mixFactor,         float, 1.0f,    0.f,   1.f, "Mix between original and effec
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_burstManager.isAnimating(); }
+
+    [[nodiscard]]
+    bool isOptional() const override { return true; }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader( const sf::RenderTexture * inputTexture ) override;
   private:
@@ -193,4 +199,4 @@ void main() {
 
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -98,6 +98,9 @@ X(mixFactor,       float, 1.0f,    0.f,   1.f, "Mix between original and effects
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader(const sf::RenderTexture * inputTexture) override;
 
@@ -166,4 +169,4 @@ void main() {
 })";
 
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -98,6 +98,12 @@ X(BlendInput,        sf::BlendMode, sf::BlendAdd, 0.f, 0.f, nullptr, false )
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
+    [[nodiscard]]
+    bool isOptional() const override { return true; }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader( const sf::RenderTexture * inputTexture ) override;
 
@@ -144,4 +150,4 @@ void main()
 
   };
 
-}
\ No newline at end of file
+}
\ No newline at end of file
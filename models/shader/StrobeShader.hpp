@@ -90,6 +90,9 @@ X(mixFactor,    float, 1.0f,    0.f,   1.f, "Mix between original and effects re
     [[nodiscard]]
     bool isShaderActive() const override;
 
+    [[nodiscard]]
+    bool isAnimating() const override { return m_easing.isAnimating(); }
+
     [[nodiscard]]
     sf::RenderTexture * applyShader( const sf::RenderTexture * inputTexture ) override;
 
@@ -119,4 +122,4 @@ void main()
     gl_FragColor = vec4(finalColor, flashColor.a);
 })";
   };
-}
\ No newline at end of file
+}
\ No newline at end of file
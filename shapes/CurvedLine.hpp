@@ -15,8 +15,13 @@
 
 #pragma once
 
+#include "shapes/CurvedLineBatch.hpp"
+
 namespace nx
 {
+  // a batch of one line, for drawing a line on its own. anything drawing many of
+  // them should append them to a CurvedLineBatch instead.
+  // lines made while a FrameArena is in scope live in it, vertices included
   class CurvedLine final : public sf::Drawable
   {
   public:
@@ -25,6 +30,22 @@ namespace nx
             const float curvature = 0.25f,
             const int segments = 32);
 
+    // everything up front, so the line is tessellated once instead of again
+    // by setWidth and setGradient
+    CurvedLine(const sf::Vector2f &start,
+            const sf::Vector2f &end,
+            const float curvature,
+            const int segments,
+            const float width,
+            const sf::Color &startColor,
+            const sf::Color &endColor);
+
+    CurvedLine(const CurvedLine&) = delete;
+    CurvedLine& operator=(const CurvedLine&) = delete;
+
+    static void * operator new( const size_t size ) { return FrameArena::allocateObject( size ); }
+    static void operator delete( void * memory ) { FrameArena::deallocateObject( memory ); }
+
     void setWidth(const float width);
 
     void setEndpoints(const sf::Vector2f &start, const sf::Vector2f &end);
@@ -38,7 +59,7 @@ namespace nx
     void update();
 
   private:
-    void draw(sf::RenderTarget &target, sf::RenderStates states) const override { target.draw(m_vertices, states); }
+    void draw(sf::RenderTarget &target, sf::RenderStates states) const override { target.draw(m_batch, states); }
 
     sf::Vector2f m_start;
     sf::Vector2f m_end;
@@ -49,7 +70,7 @@ namespace nx
     float m_width { 1.f };
     sf::Color m_color;
 
-    sf::VertexArray m_vertices;
+    CurvedLineBatch m_batch;
   };
 
 } // namespace nx
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+#include "shapes/CurvedLineBatch.hpp"
+
+#include "helpers/ColorFadeKernel.hpp"
+#include "helpers/CurvedLineKernel.hpp"
+
+namespace nx
+{
+
+  void CurvedLineBatch::append( const sf::Vector2f& start,
+                                const sf::Vector2f& end,
+                                const float curvature,
+                                int32_t segments,
+                                const float width,
+                                const sf::Color& startColor,
+                                const sf::Color& endColor )
+  {
+    segments = std::max( segments, 1 );
+
+    const auto vertexCount = m_vertexCount + getVertexCount( segments );
+    if ( vertexCount > m_vertexCapacity )
+      reserveVertices( std::max( vertexCount, m_vertexCapacity * 2 ) );
+
+    const auto dir = end - start;
+    const auto mid = 0.5f * ( start + end );
+    sf::Vector2f normal( -dir.y, dir.x );
+    const float len = std::sqrt( normal.x * normal.x + normal.y * normal.y );
+    if ( len != 0.f ) normal /= len;
+
+    const auto control = mid + normal * curvature * std::sqrt( dir.x * dir.x + dir.y * dir.y );
+
+    // the modifiers append lines on several threads at once
+    thread_local Scratch_t scratch;
+
+    const auto paddedCount = CurvedLineKernel::getPaddedCount( segments );
+    if ( scratch.percentages.size() < paddedCount )
+    {
+      scratch.percentages.resize( paddedCount );
+      scratch.left.resize( paddedCount );
+      scratch.right.resize( paddedCount );
+      scratch.colors.resize( paddedCount );
+    }
+
+    const std::span percentages { scratch.percentages.data(), paddedCount };
+    const std::span left { scratch.left.data(), paddedCount };
+    const std::span right { scratch.right.data(), paddedCount };
+    const std::span colors { scratch.colors.data(), paddedCount };
+
+    CurvedLineKernel::tessellate( start, control, end, segments, width * 0.5f, percentages, left, right );
+    ColorFadeKernel::fade( startColor, endColor, percentages, colors );
+
+    const auto pointCount = static_cast< size_t >( segments ) + 1;
+
+    sf::Vertex * out = m_vertices + m_vertexCount;
+    for ( size_t i = 1; i < pointCount; ++i )
+    {
+      const sf::Vertex previousLeft { left[ i - 1 ], colors[ i - 1 ] };
+      const sf::Vertex previousRight { right[ i - 1 ], colors[ i - 1 ] };
+      const sf::Vertex currentLeft { left[ i ], colors[ i ] };
+
+      // the quad between this point and the previous one
+      *out++ = previousLeft;
+      *out++ = previousRight;
+      *out++ = currentLeft;
+      *out++ = previousRight;
+      *out++ = { right[ i ], colors[ i ] };
+      *out++ = currentLeft;
+    }
+
+    m_vertexCount = vertexCount;
+  }
+
+  void CurvedLineBatch::reserveVertices( const size_t vertexCount )
+  {
+    if ( vertexCount <= m_vertexCapacity ) return;
+
+    if ( m_arena != nullptr )
+    {
+      // the old block stays in the arena until the next reset
+      auto * vertices = m_arena->allocateArray< sf::Vertex >( vertexCount );
+      std::copy_n( m_vertices, m_vertexCount, vertices );
+      m_vertices = vertices;
+    }
+    else
+    {
+      m_heapVertices.resize( vertexCount );
+      m_vertices = m_heapVertices.data();
+    }
+
+    m_vertexCapacity = vertexCount;
+  }
+
+}
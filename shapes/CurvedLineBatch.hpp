@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+#pragma once
+
+#include "utils/FrameArena.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Any number of curved lines as one triangle list, so they go out in a single
+  /// draw call. Each line is a quadratic curve bent away from the straight line
+  /// by the curvature, with a color gradient from start to end.
+  ///
+  /// A batch made while a FrameArena is in scope keeps its vertices in the
+  /// arena, so it must not outlive the frame (see CurvedLine).
+  class CurvedLineBatch final : public sf::Drawable
+  {
+  public:
+
+    CurvedLineBatch()
+      : m_arena( FrameArena::getCurrent() )
+    {}
+
+    CurvedLineBatch( const CurvedLineBatch& ) = delete;
+    CurvedLineBatch& operator=( const CurvedLineBatch& ) = delete;
+
+    static void * operator new( const size_t size ) { return FrameArena::allocateObject( size ); }
+    static void operator delete( void * memory ) { FrameArena::deallocateObject( memory ); }
+
+    // makes room for the lines up front, so appending them doesn't have to grow
+    void reserve( const size_t lineCount, const int32_t segments )
+    {
+      reserveVertices( m_vertexCount + lineCount * getVertexCount( segments ) );
+    }
+
+    void append( const sf::Vector2f& start,
+                 const sf::Vector2f& end,
+                 float curvature,
+                 int32_t segments,
+                 float width,
+                 const sf::Color& startColor,
+                 const sf::Color& endColor );
+
+    void append( const sf::Vector2f& start,
+                 const sf::Vector2f& end,
+                 const float curvature,
+                 const int32_t segments,
+                 const float width,
+                 const std::pair< sf::Color, sf::Color >& colors )
+    {
+      append( start, end, curvature, segments, width, colors.first, colors.second );
+    }
+
+    void clear() { m_vertexCount = 0; }
+
+    [[nodiscard]]
+    bool empty() const { return m_vertexCount == 0; }
+
+    [[nodiscard]]
+    size_t getVertexCount() const { return m_vertexCount; }
+
+    // two triangles per segment
+    static constexpr size_t getVertexCount( const int32_t segments )
+    {
+      return static_cast< size_t >( std::max( segments, 1 ) ) * 6;
+    }
+
+  private:
+
+    // where a line is tessellated before it's turned into triangles
+    struct Scratch_t
+    {
+      std::vector< float > percentages;
+      std::vector< sf::Vector2f > left;
+      std::vector< sf::Vector2f > right;
+      std::vector< sf::Color > colors;
+    };
+
+    void draw( sf::RenderTarget& target, sf::RenderStates states ) const override
+    {
+      if ( m_vertexCount > 0 )
+        target.draw( m_vertices, m_vertexCount, sf::PrimitiveType::Triangles, states );
+    }
+
+    void reserveVertices( size_t vertexCount );
+
+  private:
+
+    // where the vertices come from. without an arena they live in m_heapVertices.
+    FrameArena * m_arena { nullptr };
+    std::vector< sf::Vertex > m_heapVertices;
+
+    sf::Vertex * m_vertices { nullptr };
+    size_t m_vertexCount { 0 };
+    size_t m_vertexCapacity { 0 };
+  };
+
+}
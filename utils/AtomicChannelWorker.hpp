@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#endif
+
+#include "helpers/Definitions.hpp"
+
+#include "utils/IChannelWorker.hpp"
+#include "utils/RingBufferAverager.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Same contract as ChannelWorker, but the handshake is a pair of generation
+  /// counters instead of a mutex and two condition variables. Both sides spin
+  /// briefly before sleeping with atomic wait/notify, and the spin adapts to
+  /// how often it actually pays off.
+  class AtomicChannelWorker final : public IChannelWorker
+  {
+  public:
+    using PipelineFn = std::function< void() >;
+
+    explicit AtomicChannelWorker( PipelineFn pipelineFunc ) : m_pipelineFunc( std::move( pipelineFunc ) )
+    {
+      m_thread = std::thread( [ this ]() { threadLoop(); } );
+    }
+
+    ~AtomicChannelWorker() override
+    {
+      m_shouldExit.store( true, std::memory_order_release );
+
+      LOG_INFO( "shutting down all tasks in channel" );
+
+      // bump the generation so the thread wakes up and sees the exit flag
+      m_requestedGeneration.fetch_add( 1, std::memory_order_release );
+      m_requestedGeneration.notify_one();
+
+      if ( m_thread.joinable() )
+        m_thread.join();
+    }
+
+    // Triggers the render thread to run the pipeline once
+    void requestPipelineRun() override
+    {
+      m_requestedGeneration.fetch_add( 1, std::memory_order_release );
+      m_requestedGeneration.notify_one();
+    }
+
+    // Blocks until the pipeline thread completes the current run
+    void waitUntilComplete() override
+    {
+      const auto target = m_requestedGeneration.load( std::memory_order_acquire );
+
+      // the worker may have picked up later requests too, so anything past the target counts
+      spinThenWait( m_completedGeneration, m_waitSpinLimit, [ target ]( const uint32_t completed )
+      {
+        return static_cast< int32_t >( completed - target ) >= 0;
+      } );
+    }
+
+    [[nodiscard]]
+    bool isPipelineComplete() override
+    {
+      return m_completedGeneration.load( std::memory_order_acquire ) ==
+             m_requestedGeneration.load( std::memory_order_acquire );
+    }
+
+    // Returns the latest profiling metrics
+    [[nodiscard]]
+    double getMetrics() const override
+    {
+      return m_averager.getAverage();
+    }
+
+  private:
+
+    void threadLoop()
+    {
+      uint32_t handledGeneration = 0;
+
+      while ( true )
+      {
+        spinThenWait( m_requestedGeneration, m_runSpinLimit, [ handledGeneration ]( const uint32_t requested )
+        {
+          return requested != handledGeneration;
+        } );
+
+        if ( m_shouldExit.load( std::memory_order_acquire ) )
+          return;
+
+        // requests that arrived in the meantime are covered by this run
+        handledGeneration = m_requestedGeneration.load( std::memory_order_acquire );
+
+        m_averager.startTimer();
+
+        if ( m_pipelineFunc )
+          m_pipelineFunc();
+
+        m_averager.stopTimerAndAddSample();
+
+        m_completedGeneration.store( handledGeneration, std::memory_order_release );
+        m_completedGeneration.notify_all();
+      }
+    }
+
+    static void cpuRelax()
+    {
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+      _mm_pause();
+#else
+      std::this_thread::yield();
+#endif
+    }
+
+    // spins first and then sleeps until the counter satisfies the predicate.
+    // the spin limit grows when spinning was enough and shrinks when it wasn't.
+    template < typename TPredicate >
+    static void spinThenWait( const std::atomic< uint32_t >& counter,
+                              int32_t& spinLimit,
+                              TPredicate&& isDone )
+    {
+      for ( int32_t i = 0; i < spinLimit; ++i )
+      {
+        if ( isDone( counter.load( std::memory_order_acquire ) ) )
+        {
+          spinLimit = std::min( spinLimit * 2, MAX_SPIN_LIMIT );
+          return;
+        }
+
+        cpuRelax();
+      }
+
+      spinLimit = std::max( spinLimit / 2, MIN_SPIN_LIMIT );
+
+      auto value = counter.load( std::memory_order_acquire );
+      while ( !isDone( value ) )
+      {
+        counter.wait( value, std::memory_order_acquire );
+        value = counter.load( std::memory_order_acquire );
+      }
+    }
+
+  private:
+    static constexpr int32_t MIN_SPIN_LIMIT = 16;
+    static constexpr int32_t MAX_SPIN_LIMIT = 4096;
+
+    PipelineFn m_pipelineFunc;
+    std::thread m_thread;
+
+    // the worker and the main thread each write to their own counter
+    alignas( 64 ) std::atomic< uint32_t > m_requestedGeneration { 0 };
+    alignas( 64 ) std::atomic< uint32_t > m_completedGeneration { 0 };
+    std::atomic< bool > m_shouldExit { false };
+
+    // each side keeps its own spin limit, so there's no sharing
+    int32_t m_runSpinLimit { MIN_SPIN_LIMIT };
+    int32_t m_waitSpinLimit { MIN_SPIN_LIMIT };
+
+    RingBufferAverager m_averager { RENDER_SAMPLES_COUNT };
+  };
+
+} // namespace nx
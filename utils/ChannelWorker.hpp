@@ -21,6 +21,7 @@
 #include <mutex>
 #include <thread>
 
+#include "utils/IChannelWorker.hpp"
 #include "utils/RingBufferAverager.hpp"
 
 #include "helpers/Definitions.hpp"
@@ -28,7 +29,7 @@
 namespace nx
 {
 
-  class ChannelWorker
+  class ChannelWorker final : public IChannelWorker
   {
   public:
     using PipelineFn = std::function< void() >;
@@ -38,7 +39,7 @@ namespace nx
       m_thread = std::thread([ this ]() { threadLoop(); });
     }
 
-    ~ChannelWorker()
+    ~ChannelWorker() override
     {
       {
         std::lock_guard lock(m_mutex);
@@ -54,7 +55,7 @@ namespace nx
     }
 
     // Triggers the render thread to run the pipeline once
-    void requestPipelineRun()
+    void requestPipelineRun() override
     {
       {
         std::lock_guard lock(m_mutex);
@@ -65,14 +66,21 @@ namespace nx
     }
 
     // Blocks until the pipeline thread completes the current run
-    void waitUntilComplete()
+    void waitUntilComplete() override
     {
       std::unique_lock lock(m_mutex);
       m_pipelineCompleteCv.wait(lock, [ this ] { return m_pipelineComplete; });
     }
 
+    // Non-blocking check on whether the last requested run has finished
+    bool isPipelineComplete() override
+    {
+      std::lock_guard lock(m_mutex);
+      return m_pipelineComplete;
+    }
+
     // Returns the latest profiling metrics
-    double getMetrics() const
+    double getMetrics() const override
     {
       //std::lock_guard lock( m_metricsMutex );
       return m_averager.getAverage();
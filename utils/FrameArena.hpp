@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace nx
+{
+
+  ///
+  /// Bump allocator for everything that only lives for one frame, e.g., the
+  /// artifacts the modifiers hand over for drawing. Allocating is moving an
+  /// offset and reset() hands all of it out again, so once the chunks have
+  /// grown to fit a frame there's nothing left for the global heap to do.
+  ///
+  /// Like the particle pool, the types that live here don't know about it: their
+  /// operator new uses the arena of the current thread (see Scope), and their
+  /// operator delete only runs the heap path for memory that didn't come from
+  /// an arena. Everything in the arena must be destroyed before reset().
+  /// An arena is not thread safe, so every thread needs its own.
+  class FrameArena final
+  {
+    // sits in front of every object
+    struct alignas( std::max_align_t ) BlockHeader_t
+    {
+      FrameArena * owner { nullptr };
+    };
+
+    struct Chunk_t
+    {
+      std::unique_ptr< std::byte[] > memory;
+      size_t size { 0 };
+    };
+
+  public:
+
+    // objects created on this thread come out of the arena until it goes out of scope
+    class Scope final
+    {
+    public:
+      explicit Scope( FrameArena * arena )
+        : m_previousArena( t_currentArena )
+      {
+        t_currentArena = arena;
+      }
+
+      ~Scope() { t_currentArena = m_previousArena; }
+
+      Scope( const Scope& ) = delete;
+      Scope& operator=( const Scope& ) = delete;
+
+    private:
+      FrameArena * m_previousArena;
+    };
+
+    FrameArena() = default;
+
+    FrameArena( const FrameArena& ) = delete;
+    FrameArena& operator=( const FrameArena& ) = delete;
+
+    [[nodiscard]]
+    static FrameArena * getCurrent() { return t_currentArena; }
+
+    // used by operator new of the frame-scoped types
+    [[nodiscard]]
+    static void * allocateObject( const size_t size )
+    {
+      BlockHeader_t * header = nullptr;
+
+      if ( auto * arena = t_currentArena )
+        header = new ( arena->allocate( sizeof( BlockHeader_t ) + size, alignof( BlockHeader_t ) ) ) BlockHeader_t { arena };
+      else
+        header = new ( ::operator new( sizeof( BlockHeader_t ) + size ) ) BlockHeader_t {};
+
+      return header + 1;
+    }
+
+    // used by operator delete of the frame-scoped types
+    static void deallocateObject( void * memory )
+    {
+      if ( memory == nullptr ) return;
+
+      // arena memory is taken back by the next reset
+      auto * header = static_cast< BlockHeader_t * >( memory ) - 1;
+      if ( header->owner == nullptr )
+        ::operator delete( header );
+    }
+
+    // memory that stays valid until the next reset. nothing gets constructed.
+    [[nodiscard]]
+    void * allocate( const size_t size, const size_t alignment = alignof( std::max_align_t ) )
+    {
+      // the chunks come from new[], which aligns them at least this much
+      assert( alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ );
+
+      for ( ;; )
+      {
+        if ( m_chunkIndex == m_chunks.size() )
+        {
+          const auto chunkSize = std::max( CHUNK_SIZE, size + alignment );
+          m_chunks.push_back( { std::make_unique_for_overwrite< std::byte[] >( chunkSize ), chunkSize } );
+          m_reservedBytes += chunkSize;
+        }
+
+        auto& chunk = m_chunks[ m_chunkIndex ];
+        const auto offset = ( m_offset + alignment - 1 ) / alignment * alignment;
+
+        if ( offset + size <= chunk.size )
+        {
+          m_offset = offset + size;
+          m_usedBytes += size;
+          return chunk.memory.get() + offset;
+        }
+
+        // the rest of this chunk sits idle until the next reset
+        ++m_chunkIndex;
+        m_offset = 0;
+      }
+    }
+
+    template < typename T >
+    [[nodiscard]]
+    T * allocateArray( const size_t count )
+    {
+      static_assert( std::is_trivially_destructible_v< T >, "nothing in the arena gets destroyed" );
+      return static_cast< T * >( allocate( sizeof( T ) * count, alignof( T ) ) );
+    }
+
+    // hands out all the memory again. the chunks are kept.
+    void reset()
+    {
+      m_chunkIndex = 0;
+      m_offset = 0;
+      m_usedBytes = 0;
+    }
+
+    [[nodiscard]]
+    size_t getUsedBytes() const { return m_usedBytes; }
+
+    [[nodiscard]]
+    size_t getReservedBytes() const { return m_reservedBytes; }
+
+  private:
+
+    std::vector< Chunk_t > m_chunks;
+    size_t m_chunkIndex { 0 };
+    size_t m_offset { 0 };
+
+    size_t m_usedBytes { 0 };
+    size_t m_reservedBytes { 0 };
+
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+    inline static thread_local FrameArena * t_currentArena { nullptr };
+  };
+
+}
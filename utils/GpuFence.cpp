@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#include "utils/GpuFence.hpp"
+
+#include <atomic>
+
+#include <SFML/OpenGL.hpp>
+#include <SFML/Window/Context.hpp>
+
+#if defined WIN32
+#define NX_GL_APIENTRY __stdcall
+#else
+#define NX_GL_APIENTRY
+#endif
+
+namespace nx
+{
+  namespace
+  {
+    // these aren't in the GL 1.1 headers that come with every platform
+    constexpr GLenum SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+    constexpr GLenum ALREADY_SIGNALED = 0x911A;
+    constexpr GLenum CONDITION_SATISFIED = 0x911C;
+    constexpr uint64_t TIMEOUT_IGNORED = 0xFFFFFFFFFFFFFFFFull;
+
+    using FenceSyncFn = GpuFence::Sync ( NX_GL_APIENTRY * )( GLenum condition, GLbitfield flags );
+    using DeleteSyncFn = void ( NX_GL_APIENTRY * )( GpuFence::Sync sync );
+    using ClientWaitSyncFn = GLenum ( NX_GL_APIENTRY * )( GpuFence::Sync sync, GLbitfield flags, uint64_t timeout );
+    using WaitSyncFn = void ( NX_GL_APIENTRY * )( GpuFence::Sync sync, GLbitfield flags, uint64_t timeout );
+
+    struct SyncFunctions_t
+    {
+      FenceSyncFn fenceSync { nullptr };
+      DeleteSyncFn deleteSync { nullptr };
+      ClientWaitSyncFn clientWaitSync { nullptr };
+      WaitSyncFn waitSync { nullptr };
+
+      [[nodiscard]]
+      bool isAvailable() const
+      {
+        return fenceSync && deleteSync && clientWaitSync && waitSync;
+      }
+    };
+
+    // this needs an active context the first time around
+    const SyncFunctions_t& getSyncFunctions()
+    {
+      static const SyncFunctions_t functions = []
+      {
+        SyncFunctions_t result;
+        result.fenceSync = reinterpret_cast< FenceSyncFn >( sf::Context::getFunction( "glFenceSync" ) );
+        result.deleteSync = reinterpret_cast< DeleteSyncFn >( sf::Context::getFunction( "glDeleteSync" ) );
+        result.clientWaitSync = reinterpret_cast< ClientWaitSyncFn >( sf::Context::getFunction( "glClientWaitSync" ) );
+        result.waitSync = reinterpret_cast< WaitSyncFn >( sf::Context::getFunction( "glWaitSync" ) );
+
+        if ( !result.isAvailable() )
+        {
+          LOG_WARN( "GL sync objects are not available. Falling back to glFlush()." );
+        }
+
+        return result;
+      }();
+
+      return functions;
+    }
+
+    std::atomic< size_t > s_waitCount { 0 };
+  }
+
+  GpuFence::Sync GpuFence::insert()
+  {
+    const auto& gl = getSyncFunctions();
+    Sync sync = gl.isAvailable() ? gl.fenceSync( SYNC_GPU_COMMANDS_COMPLETE, 0 ) : nullptr;
+
+    // the consuming context can only see the fence once it's been submitted
+    glFlush();
+    return sync;
+  }
+
+  void GpuFence::destroy( const Sync sync )
+  {
+    if ( sync != nullptr )
+      getSyncFunctions().deleteSync( sync );
+  }
+
+  void GpuFence::waitOnGpu( const Sync sync )
+  {
+    if ( sync == nullptr ) return;
+
+    const auto& gl = getSyncFunctions();
+
+    // a zero timeout only polls, so this tells us whether the producer is done
+    const auto status = gl.clientWaitSync( sync, 0, 0 );
+    if ( status == ALREADY_SIGNALED || status == CONDITION_SATISFIED ) return;
+
+    s_waitCount.fetch_add( 1, std::memory_order_relaxed );
+    gl.waitSync( sync, 0, TIMEOUT_IGNORED );
+  }
+
+  size_t GpuFence::getWaitCount()
+  {
+    return s_waitCount.load( std::memory_order_relaxed );
+  }
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace nx
+{
+
+  ///
+  /// GL sync objects for handing a texture from the context that rendered it to
+  /// another one. They need GL 3.2 or ARB_sync, and the functions are looked up
+  /// at runtime. Without them, insert() only flushes and waiting is a no-op.
+  struct GpuFence
+  {
+    // opaque GLsync handle
+    using Sync = void *;
+
+    // call this on the producing context right after its draw calls. the
+    // fence gets flushed, so that other contexts are able to wait on it.
+    [[nodiscard]]
+    static Sync insert();
+
+    // GL defers the deletion while another context is still waiting on it
+    static void destroy( Sync sync );
+
+    // makes the calling context's GPU queue wait for the producer without
+    // blocking the CPU. nothing happens if the fence is already signaled.
+    static void waitOnGpu( Sync sync );
+
+    // the number of times waitOnGpu() found the producer wasn't done yet
+    [[nodiscard]]
+    static size_t getWaitCount();
+  };
+
+}
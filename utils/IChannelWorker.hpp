@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+namespace nx
+{
+
+  ///
+  /// Runs a channel's render pipeline off the main thread. The main thread
+  /// requests a run and then collects it whenever it needs the output.
+  struct IChannelWorker
+  {
+    virtual ~IChannelWorker() = default;
+
+    // Triggers the pipeline to run once
+    virtual void requestPipelineRun() = 0;
+
+    // Blocks until the pipeline completes the current run
+    virtual void waitUntilComplete() = 0;
+
+    // Non-blocking check on whether the last requested run has finished
+    [[nodiscard]]
+    virtual bool isPipelineComplete() = 0;
+
+    // Returns the average time of a run in ms
+    [[nodiscard]]
+    virtual double getMetrics() const = 0;
+  };
+
+} // namespace nx
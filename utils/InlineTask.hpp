@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nx
+{
+
+  ///
+  /// Move-only replacement for std::function< void() > that stores the callable
+  /// inline whenever it fits, so queuing a task doesn't touch the heap. Anything
+  /// larger (or not nothrow movable) falls back to a heap allocation.
+  template < size_t InlineSize >
+  class InlineTask final
+  {
+    struct Ops_t
+    {
+      void ( *invoke )( void * storage );
+      void ( *move )( void * dst, void * src );
+      void ( *destroy )( void * storage );
+      bool isHeapAllocated;
+    };
+
+    template < typename Fn >
+    static constexpr bool FITS_INLINE =
+      sizeof( Fn ) <= InlineSize &&
+      alignof( Fn ) <= alignof( std::max_align_t ) &&
+      std::is_nothrow_move_constructible_v< Fn >;
+
+    template < typename Fn >
+    static constexpr Ops_t INLINE_OPS
+    {
+      []( void * storage ) { ( *static_cast< Fn * >( storage ) )(); },
+      []( void * dst, void * src )
+      {
+        new ( dst ) Fn( std::move( *static_cast< Fn * >( src ) ) );
+        static_cast< Fn * >( src )->~Fn();
+      },
+      []( void * storage ) { static_cast< Fn * >( storage )->~Fn(); },
+      false
+    };
+
+    // the storage only holds a pointer to the callable
+    template < typename Fn >
+    static constexpr Ops_t HEAP_OPS
+    {
+      []( void * storage ) { ( **static_cast< Fn ** >( storage ) )(); },
+      []( void * dst, void * src ) { new ( dst ) Fn *( *static_cast< Fn ** >( src ) ); },
+      []( void * storage ) { delete *static_cast< Fn ** >( storage ); },
+      true
+    };
+
+  public:
+    InlineTask() = default;
+
+    template < typename F,
+               typename = std::enable_if_t< !std::is_same_v< std::decay_t< F >, InlineTask > > >
+    InlineTask( F&& fn )
+    {
+      using Fn = std::decay_t< F >;
+      static_assert( std::is_invocable_v< Fn& >, "Task must be callable with no arguments" );
+
+      if constexpr ( FITS_INLINE< Fn > )
+      {
+        new ( &m_storage ) Fn( std::forward< F >( fn ) );
+        m_ops = &INLINE_OPS< Fn >;
+      }
+      else
+      {
+        new ( &m_storage ) Fn *( new Fn( std::forward< F >( fn ) ) );
+        m_ops = &HEAP_OPS< Fn >;
+      }
+    }
+
+    InlineTask( InlineTask&& other ) noexcept
+    {
+      moveFrom( other );
+    }
+
+    InlineTask& operator=( InlineTask&& other ) noexcept
+    {
+      if ( this != &other )
+      {
+        reset();
+        moveFrom( other );
+      }
+      return *this;
+    }
+
+    InlineTask( const InlineTask& ) = delete;
+    InlineTask& operator=( const InlineTask& ) = delete;
+
+    ~InlineTask() { reset(); }
+
+    void operator()() { m_ops->invoke( &m_storage ); }
+
+    explicit operator bool() const { return m_ops != nullptr; }
+
+    [[nodiscard]]
+    bool isHeapAllocated() const { return m_ops != nullptr && m_ops->isHeapAllocated; }
+
+    void reset()
+    {
+      if ( m_ops != nullptr )
+      {
+        m_ops->destroy( &m_storage );
+        m_ops = nullptr;
+      }
+    }
+
+  private:
+
+    void moveFrom( InlineTask& other ) noexcept
+    {
+      if ( other.m_ops != nullptr )
+      {
+        other.m_ops->move( &m_storage, &other.m_storage );
+        m_ops = other.m_ops;
+        other.m_ops = nullptr;
+      }
+    }
+
+    alignas( std::max_align_t ) std::byte m_storage[ InlineSize ];
+    const Ops_t * m_ops { nullptr };
+  };
+
+} // namespace nx
@@ -31,7 +31,16 @@ namespace nx
       ensureOwner();
       m_textures[ 0 ].reset();
       m_textures[ 1 ].reset();
+
+      for ( auto& fence : m_fences )
+      {
+        GpuFence::destroy( fence );
+        fence = nullptr;
+      }
     }
+
+    GpuFence::destroy( m_consumerFence );
+    m_consumerFence = nullptr;
   }
 
   void LazyTexture::ensureSize(const sf::Vector2u &size)
@@ -55,6 +64,7 @@ namespace nx
   {
     ensureInitialized();
     ensureOwner();
+    waitOnConsumer();
     getBack()->clear(color);
   }
 
@@ -64,16 +74,32 @@ namespace nx
     ensureOwner();
     getBack()->display();
     std::swap(m_frontIndex, m_backIndex); // Swap after render completes
-    glFlush(); // <-- lightweight, non-blocking flush
+
+    if ( m_handoff == E_TextureHandoff::E_SharedContext )
+    {
+      // the old fence belongs to the frame that was last drawn into this buffer
+      GpuFence::destroy( m_fences[ m_frontIndex ] );
+      m_fences[ m_frontIndex ] = GpuFence::insert();
+    }
   }
 
   void LazyTexture::draw(const sf::Drawable &drawable, const sf::RenderStates &states)
   {
     ensureInitialized();
     ensureOwner();
+    waitOnConsumer();
     getBack()->draw(drawable, states);
   }
 
+  void LazyTexture::setConsumerFence( const GpuFence::Sync fence )
+  {
+    ensureOwner();
+
+    // a fence that was never waited on has been superseded by this one
+    GpuFence::destroy( m_consumerFence );
+    m_consumerFence = fence;
+  }
+
   void LazyTexture::ensureInitialized()
   {
     if (!m_textures[ 0 ])
@@ -86,4 +112,20 @@ namespace nx
     }
   }
 
+  void LazyTexture::waitOnConsumer()
+  {
+    if ( m_consumerFence == nullptr ) return;
+
+    // the back buffer is bound by the caller right after this, so it has to be
+    // the active context that waits. GL keeps the fence until the wait is done.
+    if ( !getBack()->setActive( true ) )
+    {
+      LOG_ERROR( "Failed to activate render texture" );
+    }
+
+    GpuFence::waitOnGpu( m_consumerFence );
+    GpuFence::destroy( m_consumerFence );
+    m_consumerFence = nullptr;
+  }
+
 }
\ No newline at end of file
@@ -20,21 +20,36 @@
 #include <memory>
 #include <thread>
 
+#include "utils/GpuFence.hpp"
+
 namespace nx
 {
 
+  enum class E_TextureHandoff : int8_t
+  {
+    // only ever sampled by the thread that renders it
+    E_SameContext,
+
+    // sampled by another thread (e.g., the channel output), so it gets a fence
+    E_SharedContext
+  };
+
   ///
   /// Lazy initialization of the sf::RenderTexture, so that any time the texture is operated
   /// on it gets initialized. This allows LazyTexture to be declared but for threads that
   /// need to use it to take ownership of it.
   ///
-  /// It uses a double-buffer strategy along with glFlush() to allow OpenGL to update
-  /// the screen. As a consequence, two textures are always allocated. The alternative
-  /// would be to use glFinish(), which is not an optimal solution.
+  /// It uses a double-buffer strategy, so two textures are always allocated. Textures
+  /// that get handed to another context put a fence behind every frame, which the
+  /// consumer waits on (see GpuFence). The consumer hands a fence back after sampling,
+  /// which the next draw into the back buffer waits on. Commands within the same
+  /// context are already ordered, so the other textures don't need any synchronization.
   class LazyTexture final
   {
   public:
-    LazyTexture() = default;
+    explicit LazyTexture( const E_TextureHandoff handoff = E_TextureHandoff::E_SameContext )
+      : m_handoff( handoff )
+    {}
 
     // this must be called from the thread that created it
     void destroy( bool isFromDestructor = false );
@@ -63,6 +78,15 @@ namespace nx
       return getFront()->getTexture();
     }
 
+    // the consumer waits on this before sampling the texture from get()
+    [[nodiscard]]
+    GpuFence::Sync getFence() const { return m_fences[ m_frontIndex ]; }
+
+    // the consumer's fence after it last sampled the textures. the next clear() or
+    // draw() waits on it, so the back buffer isn't overwritten while it's still read.
+    // the texture takes ownership of the fence.
+    void setConsumerFence( GpuFence::Sync fence );
+
     [[nodiscard]]
     bool isInitialized() const
     {
@@ -72,6 +96,8 @@ namespace nx
   private:
     void ensureInitialized();
 
+    void waitOnConsumer();
+
     void ensureOwner() const
     {
       if (std::this_thread::get_id() != m_ownerThreadId)
@@ -93,7 +119,11 @@ namespace nx
     int m_frontIndex{ 0 };
     int m_backIndex{ 1 };
 
+    E_TextureHandoff m_handoff;
+    GpuFence::Sync m_fences[ 2 ] { nullptr, nullptr };
+    GpuFence::Sync m_consumerFence { nullptr };
+
     std::thread::id m_ownerThreadId{};
   };
 
-} // namespace nx
+} // namespace nx
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include "utils/IChannelWorker.hpp"
+#include "utils/RingBufferAverager.hpp"
+#include "utils/WorkStealingPool.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Runs a channel's pipeline as a task on the shared render pool. The task is
+  /// always pinned to the same worker because the channel's textures belong to it,
+  /// but anything the pipeline spawns along the way can be stolen by idle workers.
+  class PooledChannelWorker final : public IChannelWorker
+  {
+  public:
+    using PipelineFn = std::function< void() >;
+
+    PooledChannelWorker( WorkStealingPool& pool, const size_t workerIndex, PipelineFn pipelineFunc )
+      : m_pool( pool ),
+        m_workerIndex( workerIndex % pool.getWorkerCount() ),
+        m_pipelineFunc( std::move( pipelineFunc ) )
+    {}
+
+    ~PooledChannelWorker() override
+    {
+      // the task references this worker, so it can't go away mid-run
+      m_pool.wait( m_group );
+    }
+
+    void requestPipelineRun() override
+    {
+      m_pool.submitPinned( m_workerIndex, m_group, [ this ]
+      {
+        m_averager.startTimer();
+
+        if ( m_pipelineFunc )
+          m_pipelineFunc();
+
+        m_averager.stopTimerAndAddSample();
+      } );
+    }
+
+    void waitUntilComplete() override
+    {
+      m_pool.wait( m_group );
+    }
+
+    [[nodiscard]]
+    bool isPipelineComplete() override
+    {
+      return m_group.isDone();
+    }
+
+    [[nodiscard]]
+    double getMetrics() const override
+    {
+      return m_averager.getAverage();
+    }
+
+  private:
+    WorkStealingPool& m_pool;
+    const size_t m_workerIndex;
+
+    PipelineFn m_pipelineFunc;
+    TaskGroup m_group;
+
+    RingBufferAverager m_averager { RENDER_SAMPLES_COUNT };
+  };
+
+} // namespace nx
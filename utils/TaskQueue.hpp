@@ -14,57 +14,195 @@
  */
 
 #pragma once
-#include <functional>
-#include <concurrentqueue/blockingconcurrentqueue.h>
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include "helpers/Definitions.hpp"
+#include "utils/InlineTask.hpp"
 
 namespace nx
 {
 
+  using TaskFn = InlineTask< TASK_INLINE_SIZE >;
+
   ///////////////////////////////////////////////////////////
   class RequestSink
   {
   public:
     virtual ~RequestSink() = default;
 
-    // we don’t need the interface to know about std::function
+    // the lambda gets stored inline with the task whenever it fits
     template <typename F>
     void request(F&& fn)
     {
       // perfect forwarding
-      requestImpl(std::function<void()>(std::forward<F>(fn)));
+      requestImpl(TaskFn(std::forward<F>(fn)));
     }
 
   protected:
     // override this and feed it to the internal TaskQueue or whatever implementation
     // we decide to use under the hood
-    virtual void requestImpl(std::function<void()> fn) = 0;
+    virtual void requestImpl(TaskFn fn) = 0;
   };
 
   ///////////////////////////////////////////////////////////
+  /// Fixed-capacity ring of tasks (bounded MPMC queue using per-cell sequence numbers).
+  /// Nothing gets allocated in steady state. Tasks only spill onto the heap when
+  /// their captures don't fit inline or when the ring is full, and each case has its own count.
   class TaskQueue final
   {
+    struct Cell_t
+    {
+      std::atomic< size_t > sequence { 0 };
+      TaskFn task;
+    };
+
+    static_assert((TASK_QUEUE_CAPACITY & (TASK_QUEUE_CAPACITY - 1)) == 0,
+                  "TASK_QUEUE_CAPACITY must be a power of two");
+
+    static constexpr size_t CAPACITY_MASK = TASK_QUEUE_CAPACITY - 1;
+
   public:
-    using TaskFn = std::function<void()>;
 
-    // Delay type-erasure as long as possible.
-    // Uses a templated pushTask() that wraps the lambda once into
-    // a std::function<void()> right before enqueue
+    TaskQueue()
+    {
+      for (size_t i = 0; i < m_cells.size(); ++i)
+        m_cells[ i ].sequence.store(i, std::memory_order_relaxed);
+    }
+
     template <typename F>
     void pushTask(F&& task)
     {
       static_assert(std::is_invocable_v<F>, "Task must be callable with no arguments");
-      m_queue.enqueue(TaskFn(std::forward<F>(task)));
+
+      TaskFn fn(std::forward<F>(task));
+      if (fn.isHeapAllocated())
+        m_heapTaskCount.fetch_add(1, std::memory_order_relaxed);
+
+      // once something spilled over, everything follows it to keep the order
+      if (m_overflowCount.load(std::memory_order_acquire) == 0 && tryEnqueue(fn))
+        return;
+
+      std::lock_guard lock(m_overflowMutex);
+      m_overflow.push_back(std::move(fn));
+      m_overflowCount.fetch_add(1, std::memory_order_release);
+      m_overflowTaskCount.fetch_add(1, std::memory_order_relaxed);
     }
 
     void runTasks()
     {
       TaskFn task;
-      while (m_queue.try_dequeue(task))
+      while (tryDequeue(task))
+      {
         task();
+        task.reset();
+      }
+
+      if (m_overflowCount.load(std::memory_order_acquire) > 0)
+      {
+        std::deque< TaskFn > overflow;
+        {
+          std::lock_guard lock(m_overflowMutex);
+          overflow.swap(m_overflow);
+          m_overflowCount.store(0, std::memory_order_release);
+        }
+
+        for (auto& overflowTask : overflow)
+          overflowTask();
+      }
+    }
+
+    // approximate, but exact whenever the consumer is idle
+    bool hasPendingTasks() const
+    {
+      return m_enqueuePos.load(std::memory_order_acquire) != m_dequeuePos.load(std::memory_order_acquire) ||
+             m_overflowCount.load(std::memory_order_acquire) > 0;
+    }
+
+    // number of tasks whose captures didn't fit inline
+    size_t getHeapTaskCount() const
+    {
+      return m_heapTaskCount.load(std::memory_order_relaxed);
+    }
+
+    // number of tasks that went to the overflow queue because the ring was full
+    size_t getOverflowTaskCount() const
+    {
+      return m_overflowTaskCount.load(std::memory_order_relaxed);
     }
 
   private:
-    moodycamel::BlockingConcurrentQueue<TaskFn> m_queue;
+
+    // only moves out of the task when it succeeds
+    bool tryEnqueue(TaskFn& task)
+    {
+      size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+      Cell_t * cell;
+
+      while (true)
+      {
+        cell = &m_cells[ pos & CAPACITY_MASK ];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast< intptr_t >(sequence) - static_cast< intptr_t >(pos);
+
+        if (diff == 0)
+        {
+          if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0)
+          return false; // full
+        else
+          pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+
+      cell->task = std::move(task);
+      cell->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool tryDequeue(TaskFn& outTask)
+    {
+      size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+      Cell_t * cell;
+
+      while (true)
+      {
+        cell = &m_cells[ pos & CAPACITY_MASK ];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast< intptr_t >(sequence) - static_cast< intptr_t >(pos + 1);
+
+        if (diff == 0)
+        {
+          if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0)
+          return false; // empty
+        else
+          pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+
+      outTask = std::move(cell->task);
+      cell->sequence.store(pos + CAPACITY_MASK + 1, std::memory_order_release);
+      return true;
+    }
+
+    std::array< Cell_t, TASK_QUEUE_CAPACITY > m_cells;
+
+    // keep the producer and consumer positions on separate cache lines
+    alignas(64) std::atomic< size_t > m_enqueuePos { 0 };
+    alignas(64) std::atomic< size_t > m_dequeuePos { 0 };
+
+    std::mutex m_overflowMutex;
+    std::deque< TaskFn > m_overflow;
+    std::atomic< int32_t > m_overflowCount { 0 };
+
+    std::atomic< size_t > m_heapTaskCount { 0 };
+    std::atomic< size_t > m_overflowTaskCount { 0 };
   };
 
   ///////////////////////////////////////////////////////////
@@ -81,8 +219,23 @@ namespace nx
       m_taskQueue.runTasks();
     }
 
+    bool hasPendingTasks() const
+    {
+      return m_taskQueue.hasPendingTasks();
+    }
+
+    size_t getHeapTaskCount() const
+    {
+      return m_taskQueue.getHeapTaskCount();
+    }
+
+    size_t getOverflowTaskCount() const
+    {
+      return m_taskQueue.getOverflowTaskCount();
+    }
+
   protected:
-    void requestImpl(std::function<void()> fn) override
+    void requestImpl(TaskFn fn) override
     {
       m_taskQueue.pushTask(std::move(fn));
     }
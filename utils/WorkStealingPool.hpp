@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2025 Nicholas Reimer <nicholas.hans@gmail.com>
+ *
+ * This file is part of a project licensed under the GNU Affero General Public License v3.0,
+ * with an additional non-commercial use restriction.
+ *
+ * You may redistribute and/or modify this file under the terms of the GNU AGPLv3 as
+ * published by the Free Software Foundation, provided that your use is strictly non-commercial.
+ *
+ * This software is provided "as-is", without any warranty of any kind.
+ * See the LICENSE file in the root of the repository for full license terms.
+ *
+ * SPDX-License-Identifier: AGPL-3.0-only
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "helpers/Definitions.hpp"
+
+#include "utils/InlineTask.hpp"
+#include "utils/RingBufferAverager.hpp"
+
+namespace nx
+{
+
+  ///
+  /// Counts outstanding tasks so that a caller can wait on a batch of them.
+  /// Waiting uses atomic wait/notify, so no locks are taken on completion.
+  class TaskGroup final
+  {
+  public:
+    [[nodiscard]]
+    bool isDone() const { return m_pending.load( std::memory_order_acquire ) == 0; }
+
+  private:
+    friend class WorkStealingPool;
+
+    void add() { m_pending.fetch_add( 1, std::memory_order_relaxed ); }
+
+    void complete()
+    {
+      if ( m_pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+        m_pending.notify_all();
+    }
+
+    void waitUntilDone() const
+    {
+      int32_t pending = m_pending.load( std::memory_order_acquire );
+      while ( pending != 0 )
+      {
+        m_pending.wait( pending, std::memory_order_acquire );
+        pending = m_pending.load( std::memory_order_acquire );
+      }
+    }
+
+    std::atomic< int32_t > m_pending { 0 };
+  };
+
+  ///
+  /// Fixed set of worker threads, each with its own task deque. Workers pop their
+  /// own work LIFO and steal FIFO from the others when they run dry.
+  ///
+  /// Anything touching OpenGL has to be pinned to a worker because a LazyTexture
+  /// belongs to the thread that first used it. Pinned tasks are never stolen.
+  class WorkStealingPool final
+  {
+    // small captures are stored inline, so submitting doesn't allocate
+    using TaskFn = InlineTask< TASK_INLINE_SIZE >;
+
+    struct Task_t
+    {
+      TaskFn fn;
+      TaskGroup * group { nullptr };
+    };
+
+    struct Worker_t
+    {
+      std::mutex mutex;
+      std::deque< Task_t > tasks;
+      std::deque< Task_t > pinnedTasks;
+      std::atomic< int32_t > pinnedCount { 0 };
+
+      std::thread thread;
+
+      // nanoseconds spent running tasks since the last utilization sample
+      std::atomic< int64_t > busyTime { 0 };
+      RingBufferAverager utilization { RENDER_SAMPLES_COUNT };
+    };
+
+  public:
+
+    explicit WorkStealingPool( const size_t workerCount = getDefaultWorkerCount() )
+    {
+      m_workers.reserve( workerCount );
+      for ( size_t i = 0; i < workerCount; ++i )
+        m_workers.emplace_back( std::make_unique< Worker_t >() );
+
+      // all the workers need to exist before any of them try to steal
+      for ( size_t i = 0; i < workerCount; ++i )
+        m_workers[ i ]->thread = std::thread( [ this, i ] { threadLoop( i ); } );
+
+      m_lastSampleTime = Clock::now();
+      LOG_INFO( "render pool started with {} workers", workerCount );
+    }
+
+    ~WorkStealingPool()
+    {
+      {
+        std::lock_guard lock( m_mutex );
+        m_shouldExit = true;
+      }
+      m_cv.notify_all();
+
+      for ( const auto& worker : m_workers )
+      {
+        if ( worker->thread.joinable() )
+          worker->thread.join();
+      }
+    }
+
+    // leave a core for the main thread, which composites and handles the UI
+    static size_t getDefaultWorkerCount()
+    {
+      const auto cores = std::thread::hardware_concurrency();
+      return cores > 1 ? cores - 1 : 1;
+    }
+
+    [[nodiscard]]
+    size_t getWorkerCount() const { return m_workers.size(); }
+
+    // schedules a task that any worker is free to steal
+    template < typename F >
+    void submit( TaskGroup& group, F&& fn )
+    {
+      group.add();
+
+      // keep work spawned from a worker local to that worker until someone steals it
+      const auto workerIndex = ( t_workerIndex >= 0 )
+        ? static_cast< size_t >( t_workerIndex )
+        : m_nextWorker.fetch_add( 1, std::memory_order_relaxed ) % m_workers.size();
+
+      auto& worker = *m_workers[ workerIndex ];
+      {
+        std::lock_guard lock( worker.mutex );
+        worker.tasks.push_back( { TaskFn( std::forward< F >( fn ) ), &group } );
+      }
+
+      m_queuedCount.fetch_add( 1, std::memory_order_release );
+      wakeWorkers();
+    }
+
+    // schedules a task that can only run on the given worker
+    template < typename F >
+    void submitPinned( const size_t workerIndex, TaskGroup& group, F&& fn )
+    {
+      group.add();
+
+      auto& worker = *m_workers[ workerIndex % m_workers.size() ];
+      {
+        std::lock_guard lock( worker.mutex );
+        worker.pinnedTasks.push_back( { TaskFn( std::forward< F >( fn ) ), &group } );
+      }
+
+      worker.pinnedCount.fetch_add( 1, std::memory_order_release );
+      wakeWorkers();
+    }
+
+    // waits until every task in the group is done. the caller helps out with
+    // stealable tasks in the meantime, but never runs someone else's pinned work.
+    void wait( TaskGroup& group )
+    {
+      while ( !group.isDone() )
+      {
+        Task_t task;
+        if ( stealTask( task ) )
+          runTask( task, t_workerIndex );
+        else
+        {
+          group.waitUntilDone();
+          return;
+        }
+      }
+    }
+
+    // call once per frame from the main thread
+    void sampleUtilization()
+    {
+      const auto now = Clock::now();
+      const auto elapsed =
+        std::chrono::duration_cast< std::chrono::nanoseconds >( now - m_lastSampleTime ).count();
+
+      if ( elapsed <= 0 ) return;
+
+      m_lastSampleTime = now;
+      for ( const auto& worker : m_workers )
+      {
+        const auto busyTime = worker->busyTime.exchange( 0, std::memory_order_relaxed );
+        worker->utilization.addSample(
+          std::min( 100.0, 100.0 * static_cast< double >( busyTime ) / static_cast< double >( elapsed ) ) );
+      }
+    }
+
+    // percentage of time the worker spent running tasks
+    [[nodiscard]]
+    double getUtilization( const size_t workerIndex ) const
+    {
+      return m_workers[ workerIndex ]->utilization.getAverage();
+    }
+
+  private:
+
+    using Clock = RingBufferAverager::Clock;
+
+    void wakeWorkers()
+    {
+      // pinned work can only be picked up by one worker, so everybody gets woken up
+      {
+        std::lock_guard lock( m_mutex );
+      }
+      m_cv.notify_all();
+    }
+
+    [[nodiscard]]
+    bool hasWork( const size_t workerIndex ) const
+    {
+      return m_queuedCount.load( std::memory_order_acquire ) > 0 ||
+             m_workers[ workerIndex ]->pinnedCount.load( std::memory_order_acquire ) > 0;
+    }
+
+    void threadLoop( const size_t workerIndex )
+    {
+      t_workerIndex = static_cast< int32_t >( workerIndex );
+
+      while ( true )
+      {
+        Task_t task;
+        if ( popTask( workerIndex, task ) )
+        {
+          runTask( task, t_workerIndex );
+          continue;
+        }
+
+        std::unique_lock lock( m_mutex );
+        m_cv.wait( lock, [ this, workerIndex ] { return m_shouldExit || hasWork( workerIndex ); } );
+
+        if ( m_shouldExit )
+          return;
+      }
+    }
+
+    bool popTask( const size_t workerIndex, Task_t& outTask )
+    {
+      auto& worker = *m_workers[ workerIndex ];
+
+      {
+        std::lock_guard lock( worker.mutex );
+
+        if ( !worker.pinnedTasks.empty() )
+        {
+          outTask = std::move( worker.pinnedTasks.front() );
+          worker.pinnedTasks.pop_front();
+          worker.pinnedCount.fetch_sub( 1, std::memory_order_acq_rel );
+          return true;
+        }
+
+        if ( !worker.tasks.empty() )
+        {
+          outTask = std::move( worker.tasks.back() );
+          worker.tasks.pop_back();
+          m_queuedCount.fetch_sub( 1, std::memory_order_acq_rel );
+          return true;
+        }
+      }
+
+      return stealTask( outTask );
+    }
+
+    bool stealTask( Task_t& outTask )
+    {
+      if ( m_queuedCount.load( std::memory_order_acquire ) == 0 )
+        return false;
+
+      const auto start = ( t_workerIndex >= 0 ) ? static_cast< size_t >( t_workerIndex ) + 1 : 0;
+      for ( size_t i = 0; i < m_workers.size(); ++i )
+      {
+        auto& victim = *m_workers[ ( start + i ) % m_workers.size() ];
+
+        std::lock_guard lock( victim.mutex );
+        if ( !victim.tasks.empty() )
+        {
+          outTask = std::move( victim.tasks.front() );
+          victim.tasks.pop_front();
+          m_queuedCount.fetch_sub( 1, std::memory_order_acq_rel );
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void runTask( Task_t& task, const int32_t workerIndex )
+    {
+      const auto start = Clock::now();
+
+      task.fn();
+
+      // helping threads outside the pool aren't tracked
+      if ( workerIndex >= 0 )
+      {
+        m_workers[ workerIndex ]->busyTime.fetch_add(
+          std::chrono::duration_cast< std::chrono::nanoseconds >( Clock::now() - start ).count(),
+          std::memory_order_relaxed );
+      }
+
+      task.group->complete();
+    }
+
+  private:
+
+    std::vector< std::unique_ptr< Worker_t > > m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_shouldExit { false };
+
+    // stealable tasks across all workers
+    std::atomic< int32_t > m_queuedCount { 0 };
+    std::atomic< size_t > m_nextWorker { 0 };
+
+    RingBufferAverager::TimePoint m_lastSampleTime;
+
+    // -1 for threads that don't belong to the pool (e.g., the main thread)
+    inline static thread_local int32_t t_workerIndex { -1 };
+  };
+
+} // namespace nx
@@ -27,7 +27,12 @@ namespace nx
 {
 
   ///
-  /// Double-buffer for easy production and consumption.
+  /// Small ring of FFT frames between one producer and one consumer. Every frame
+  /// gets a sequence number, so the consumer sees each frame exactly once no
+  /// matter how the audio rate and the render rate line up.
+  /// Every slot is a seqlock: the consumer copies a frame out and only hands it
+  /// over when the slot still holds the same frame afterward, so a frame that the
+  /// producer overwrote in the meantime gets dropped instead of torn.
   /// it also keeps track of staleness in case drift happens.
   class FFTBuffer final
   {
@@ -36,15 +41,40 @@ namespace nx
     using Clock = std::chrono::steady_clock;
     using TimePoint = Clock::time_point;
 
-    [[nodiscard]]
-    AudioDataBuffer& getBuffer()
+    /// hands every frame written since the last call to onFrame, oldest first.
+    /// a consumer that fell behind by more than the ring holds loses the oldest frames.
+    /// @return the number of frames handed over
+    template < typename F >
+    size_t consumeFrames( F&& onFrame )
     {
-      if ( m_hasNewData.exchange( false, std::memory_order_acq_rel ) )
-        std::swap(m_frontBuffer, m_backBuffer);
+      const auto writeSequence = m_writeSequence.load( std::memory_order_acquire );
+
+      auto sequence = m_readSequence;
+      if ( writeSequence - sequence > FRAME_COUNT )
+      {
+        m_droppedFrameCount += writeSequence - sequence - FRAME_COUNT;
+        sequence = writeSequence - FRAME_COUNT;
+      }
 
-      return m_frontBuffer;
+      size_t count = 0;
+      while ( sequence < writeSequence )
+      {
+        if ( readFrame( ++sequence, m_readFrame ) )
+        {
+          onFrame( m_readFrame );
+          ++count;
+        }
+        else
+          ++m_droppedFrameCount;
+      }
+
+      m_readSequence = writeSequence;
+      return count;
     }
 
+    [[nodiscard]]
+    uint64_t getDroppedFrameCount() const { return m_droppedFrameCount; }
+
     /// Unpacks the VST message and writes to the internal buffer
     /// @param message
     void write( Steinberg::Vst::IMessage * message )
@@ -60,25 +90,21 @@ namespace nx
         return;
       }
 
-      if (rawSize != sizeof(float) * m_backBuffer.size())
+      if (rawSize != sizeof(float) * FFT_BINS)
       {
         LOG_ERROR("FFTData message has wrong size. got {}, expected {}",
-                  rawSize, m_backBuffer.size() * sizeof(float));
+                  rawSize, FFT_BINS * sizeof(float));
         return;
       }
 
-      std::memcpy( m_backBuffer.data(), rawPtr, rawSize );
-      m_lastWrite = Clock::now();
-      m_hasNewData.store(true, std::memory_order_release);
+      publish( rawPtr );
     }
 
     /// copies the Audio data from the processor over
     /// @param buffer the audio buffer directly from the AudioAnalyzer
     void write( const AudioDataBuffer & buffer )
     {
-      std::memcpy( m_backBuffer.data(), buffer.data(), buffer.size() * sizeof( float ) );
-      m_lastWrite = Clock::now();
-      m_hasNewData.store(true, std::memory_order_release);
+      publish( buffer.data() );
     }
 
     [[nodiscard]]
@@ -95,12 +121,60 @@ namespace nx
     }
 
   private:
-    std::atomic< bool > m_hasNewData { false };
-    AudioDataBuffer m_frontBuffer {};
-    AudioDataBuffer m_backBuffer {};
+
+    struct Slot_t
+    {
+      // the sequence of the frame in the slot, or WRITING while it's being replaced
+      std::atomic< uint64_t > sequence { 0 };
+      AudioDataBuffer frame {};
+    };
+
+    void publish( const void * data )
+    {
+      // only the producer writes the sequence, so a relaxed load is enough here
+      const auto sequence = m_writeSequence.load( std::memory_order_relaxed ) + 1;
+      auto& slot = m_slots[ sequence % FRAME_COUNT ];
+
+      slot.sequence.store( WRITING, std::memory_order_relaxed );
+      std::atomic_thread_fence( std::memory_order_release );
+
+      std::memcpy( slot.frame.data(), data, sizeof( AudioDataBuffer ) );
+      m_lastWrite = Clock::now();
+
+      slot.sequence.store( sequence, std::memory_order_release );
+      m_writeSequence.store( sequence, std::memory_order_release );
+    }
+
+    // copies the frame out, and fails when the slot doesn't hold it from start to finish
+    bool readFrame( const uint64_t sequence, AudioDataBuffer& outFrame ) const
+    {
+      const auto& slot = m_slots[ sequence % FRAME_COUNT ];
+      if ( slot.sequence.load( std::memory_order_acquire ) != sequence )
+        return false;
+
+      std::memcpy( outFrame.data(), slot.frame.data(), sizeof( AudioDataBuffer ) );
+
+      std::atomic_thread_fence( std::memory_order_acquire );
+      return slot.sequence.load( std::memory_order_relaxed ) == sequence;
+    }
+
+  private:
+
+    static constexpr uint64_t FRAME_COUNT = 8;
+    static constexpr uint64_t WRITING = UINT64_MAX;
+
+    std::array< Slot_t, FRAME_COUNT > m_slots {};
+
+    // written by the producer
+    std::atomic< uint64_t > m_writeSequence { 0 };
+
+    // only touched by the consumer
+    uint64_t m_readSequence { 0 };
+    uint64_t m_droppedFrameCount { 0 };
+    AudioDataBuffer m_readFrame {};
 
     TimePoint m_lastWrite { Clock::now() };
   };
 
 
-}
\ No newline at end of file
+}
\ No newline at end of file